@@ -0,0 +1,49 @@
+// Minimal timing helpers shared by hex-encode.js and hex-decode.js (no dependencies)
+
+function measure(fn, minMs = 250) {
+	// Warm up (and let the JIT settle)
+	for (let i = 0; i < 3; i++) fn();
+	let iterations = 0;
+	const start = process.hrtime.bigint();
+	let elapsed = 0n;
+	const minNs = BigInt(minMs) * 1000000n;
+	do {
+		fn();
+		iterations++;
+		elapsed = process.hrtime.bigint() - start;
+	} while (elapsed < minNs);
+	return iterations / (Number(elapsed) / 1e9);
+}
+
+async function measureAsync(fn, minMs = 250) {
+	for (let i = 0; i < 3; i++) await fn();
+	let iterations = 0;
+	const start = process.hrtime.bigint();
+	let elapsed = 0n;
+	const minNs = BigInt(minMs) * 1000000n;
+	do {
+		await fn();
+		iterations++;
+		elapsed = process.hrtime.bigint() - start;
+	} while (elapsed < minNs);
+	return iterations / (Number(elapsed) / 1e9);
+}
+
+function padLeft(input, size) {
+	return String(input).padStart(size);
+}
+
+// Raw (binary) MB/s for the given rate and raw length
+function formatRate(opsPerSec, rawLength) {
+	return ((opsPerSec * rawLength) / 1e6).toFixed(1);
+}
+
+function pattern(length) {
+	const buf = Buffer.alloc(length);
+	for (let i = 0; i < length; i++) buf[i] = Math.floor(Math.random() * 256);
+	return buf;
+}
+
+const rawLengths = [16, 256, 4096, 65536, 1 << 20, 16 << 20];
+
+module.exports = {measure, measureAsync, padLeft, formatRate, pattern, rawLengths};
@@ -1,39 +1,35 @@
 {
-  "conditions": [
-    ['OS=="win"', {
-      "variables": {
-        "has_avx2%": "<!(.\util\cpuinfo.exe 1 5 7)"
-      }
-    }]
-  ],
   "targets": [
     {
-      "target_name": "strdecode",
+      "target_name": "heks",
       "sources": [
-        "src/strdecode.cc",
-        "src/hex.cc"
+        "node/heks_node.cc"
+      ],
+      "include_dirs": [
+        "include"
       ],
-      "include_dirs" : [
-          "<!(node -e \"require('nan')\")"
+      "defines": [
+        "FAST_HEX_USE_NAMESPACE=1"
       ],
-      "cflags":[
+      "cflags_cc": [
+        "-std=c++20",
+        "-O3",
         "-march=native"
       ],
-      "conditions": [
-        ['OS=="win" and has_avx2==1', {
-          "msvs_settings": {
-            "VCCLCompilerTool": {
-              "EnableEnhancedInstructionSet": 5 # /arch:AVX2
-            }
-          }
-        }, {
-          "msvs_settings": {
-            "VCCLCompilerTool": {
-              "EnableEnhancedInstructionSet": 3 # /arch:AVX
-            }
-          }
-        }]
-      ]
+      "xcode_settings": {
+        "CLANG_CXX_LANGUAGE_STANDARD": "c++20",
+        "OTHER_CPLUSPLUSFLAGS": [
+          "-O3",
+          "-march=native"
+        ]
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "AdditionalOptions": [
+            "/std:c++20"
+          ]
+        }
+      }
     }
   ]
 }
@@ -58,6 +58,23 @@ if(
     set(fast_hex_ENABLE_NEON OFF)
 endif()
 
+# The portable kernels need the GCC/Clang vector extensions with __builtin_shufflevector (GCC 12+)
+if(fast_hex_ENABLE_GENERIC_SIMD)
+    include(CheckCXXSourceCompiles)
+    check_cxx_source_compiles(
+        "typedef unsigned char v16 __attribute__((vector_size(16)));
+        int main() { v16 a = {}; v16 b = __builtin_shufflevector(a, a, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23); return b[0]; }"
+        CXX_SUPPORTS_VECTOR_EXTENSIONS
+    )
+    if(NOT CXX_SUPPORTS_VECTOR_EXTENSIONS)
+        message(
+            STATUS
+            "Compiler lacks vector extensions / __builtin_shufflevector, disabling fast_hex_ENABLE_GENERIC_SIMD"
+        )
+        set(fast_hex_ENABLE_GENERIC_SIMD OFF)
+    endif()
+endif()
+
 function(fast_hex_target_enable_simd target_name)
     # Apply AVX if enabled
     if(fast_hex_ENABLE_AVX)
@@ -78,4 +95,13 @@ function(fast_hex_target_enable_simd target_name)
         message(STATUS "Enabling NEON for: ${target_name}")
         target_compile_definitions(${target_name} PRIVATE FAST_HEX_NEON=1)
     endif()
+
+    # Apply the portable vector kernels if enabled
+    if(fast_hex_ENABLE_GENERIC_SIMD)
+        message(STATUS "Enabling generic SIMD for: ${target_name}")
+        target_compile_definitions(
+            ${target_name}
+            PRIVATE FAST_HEX_GENERIC_SIMD=1
+        )
+    endif()
 endfunction()
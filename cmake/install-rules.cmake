@@ -15,7 +15,21 @@ set(package fast_hex)
 
 # Install header-only library unconditionally
 install(
-    FILES include/fast_hex/fast_hex_inline.hpp
+    FILES
+        include/fast_hex/fast_hex_base64.hpp
+        include/fast_hex/fast_hex_carray.hpp
+        include/fast_hex/fast_hex_compare.hpp
+        include/fast_hex/fast_hex_crc32c.hpp
+        include/fast_hex/fast_hex_file.hpp
+        include/fast_hex/fast_hex_format.hpp
+        include/fast_hex/fast_hex_inline.hpp
+        include/fast_hex/fast_hex_nibble.hpp
+        include/fast_hex/fast_hex_percent.hpp
+        include/fast_hex/fast_hex_pipeline.hpp
+        include/fast_hex/fast_hex_records.hpp
+        include/fast_hex/fast_hex_scan.hpp
+        include/fast_hex/fast_hex_stats.hpp
+        include/fast_hex/fast_hex_tune.hpp
     DESTINATION "${CMAKE_INSTALL_INCLUDEDIR}/fast_hex"
     COMPONENT fast_hex_Development
 )
@@ -13,6 +13,22 @@ if(PROJECT_IS_TOP_LEVEL)
     option(fast_hex_ENABLE_AVX "AVX code will be used" ON)
     option(fast_hex_ENABLE_AVX2 "AVX2 code will be used" ON)
     option(fast_hex_ENABLE_NEON "NEON code will be used" ON)
+    option(
+        fast_hex_ENABLE_GENERIC_SIMD
+        "Portable vector extension code will be used (GCC/Clang)"
+        ON
+    )
+    option(
+        fast_hex_ENABLE_TUNING
+        "encode_auto/decode_auto consult the dispatch table installed by heks::tune()"
+        OFF
+    )
+    option(
+        fast_hex_ENABLE_STATS
+        "Count calls, bytes and sizes per entry point (see stats_snapshot())"
+        OFF
+    )
+    option(fast_hex_BUILD_TOOLS "Build the heks command-line tool" OFF)
 endif()
 
 # ---- Suppress C4251 on Windows ----
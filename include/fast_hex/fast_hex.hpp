@@ -21,6 +21,10 @@
 #    define FAST_HEX_NAMESPACE_CLOSE
 #endif
 
+#if defined(FAST_HEX_STATS)
+#    include "fast_hex_stats.hpp"
+#endif
+
 FAST_HEX_NAMESPACE_OPEN
 
 // Decoders
@@ -41,11 +45,34 @@ FAST_HEX_EXPORT void decodeHexLUT4(uint8_t * FAST_HEX_RESTRICT dest, const uint8
 // [0xAB, 0xCD] -> 0xAB ... by directly applying bit manipulation to extract each nibble
 FAST_HEX_EXPORT void decodeHexBMI(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 
+// SWAR version: 16 hex characters per iteration in two 64-bit registers, arithmetic only (no tables).
+// The portable fallback where no SIMD kernel is available, and for cache-cold calls.
+FAST_HEX_EXPORT void decodeHexSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+// Portable 16-byte vector version (GCC/Clang vector extensions), for targets without a hand-written SIMD kernel
+FAST_HEX_EXPORT void decodeHexGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
 #if defined(FAST_HEX_AVX2)
 // Optimal AVX2 vectorized version. len is number of dest bytes (1/2 the size of src).
 FAST_HEX_EXPORT void decodeHexVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+// AVX2 alternative built on maddubs (as decode_integral8), 64 characters per iteration without cross-lane shuffles
+FAST_HEX_EXPORT void decodeHexVecMaddubs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 #endif // defined(FAST_HEX_AVX2)
 
+// UTF-16 input (hex strings from JavaScript, Java/JNI, Qt or Windows), without narrowing to a temporary.
+// len is number of dest bytes (1/2 the number of code units). Code units are narrowed to bytes and decoded
+// like the functions above; returns false if any of them is above 0xFF (dest is then unspecified).
+FAST_HEX_EXPORT bool decodeHexBMI16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len);
+#if defined(FAST_HEX_AVX2)
+// Narrows with _mm256_packus_epi16 into the decodeHexVec pipeline
+FAST_HEX_EXPORT bool decodeHexVec16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len);
+#endif // defined(FAST_HEX_AVX2)
+#if defined(FAST_HEX_NEON)
+FAST_HEX_EXPORT bool decodeHexNeon16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len);
+#endif // FAST_HEX_NEON
+
 // Encoders
 // Encode src bytes (e.g. "Test123") into dest hex string (e.g. "54657374313233")
 
@@ -55,6 +82,24 @@ FAST_HEX_EXPORT void decodeHexVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_
 FAST_HEX_EXPORT void encodeHexLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 FAST_HEX_EXPORT void encodeHexUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 
+// SWAR version: 8 bytes per iteration, nibbles spread over 64-bit lanes and turned into characters with
+// + '0' and a branchless > 9 adjustment (no tables)
+FAST_HEX_EXPORT void encodeHexLowerSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpperSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+// Portable 16-byte vector version (GCC/Clang vector extensions), for targets without a hand-written SIMD kernel
+FAST_HEX_EXPORT void encodeHexLowerGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpperGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
+// UTF-16 (char16_t) / UTF-32 (char32_t) output, e.g. for JavaScript or Java strings. len is number of src bytes,
+// dest holds 2 * len code units.
+FAST_HEX_EXPORT void encodeHexLower16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpper16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexLower32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpper32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+
 
 #if defined(FAST_HEX_AVX)
 // Fast specialized paths for fixed-size encoding
@@ -68,26 +113,56 @@ FAST_HEX_EXPORT void encodeHexUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint
 //                 -> result = [A, B, C, D, E, F, 1, 2, 3, 4, 5, 6, 7, 8, 9]
 FAST_HEX_EXPORT void encodeHex8LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 FAST_HEX_EXPORT void encodeHex8UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+
+// Fast specialized paths for fixed-size decoding, no loop and no tail: rebase the characters to their
+// digit values, then maddubs with 0x0110 makes hi * 16 + lo of every pair
+// Decode exactly 16 hex characters (source) into 8 bytes (dest)
+FAST_HEX_EXPORT void decodeHex8Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+// Decode exactly 32 hex characters (source) into 16 bytes (dest)
+FAST_HEX_EXPORT void decodeHex16Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif
 
 #if defined(FAST_HEX_AVX2)
 // AVX2 vectorized version. len is number of src bytes. dest must be twice the size of src.
 FAST_HEX_EXPORT void encodeHexLowerVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 FAST_HEX_EXPORT void encodeHexUpperVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+// Same, zero-extending the characters with _mm256_cvtepu8_epi16/epi32 while storing
+FAST_HEX_EXPORT void encodeHexLowerVec16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpperVec16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexLowerVec32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexUpperVec32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 
 // Encode exactly 16 bytes (source) into 32 hex characters (dest)
 FAST_HEX_EXPORT void encodeHex16LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 FAST_HEX_EXPORT void encodeHex16UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+
+// Decode exactly 64 hex characters (source) into 32 bytes (dest)
+FAST_HEX_EXPORT void decodeHex32Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif // defined(FAST_HEX_AVX2)
 
 #if defined(FAST_HEX_NEON)
 // ARM NEON optimized version
 FAST_HEX_EXPORT void encodeHexNeonLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 FAST_HEX_EXPORT void encodeHexNeonUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexNeonLower16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexNeonUpper16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexNeonLower32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
+FAST_HEX_EXPORT void encodeHexNeonUpper32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 FAST_HEX_EXPORT void encodeHex8LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 FAST_HEX_EXPORT void encodeHex8UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 FAST_HEX_EXPORT void encodeHex16LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 FAST_HEX_EXPORT void encodeHex16UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+// Decode exactly 16, 32 or 64 hex characters (source) into 8, 16 or 32 bytes (dest), with vld2 loads
+FAST_HEX_EXPORT void decodeHex8Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+FAST_HEX_EXPORT void decodeHex16Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+FAST_HEX_EXPORT void decodeHex32Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif // FAST_HEX_NEON
 
+#if defined(FAST_HEX_STATS)
+// Hot-path statistics (fast_hex_ENABLE_STATS): calls, bytes and log2 size histograms per entry point and
+// per fallback, summed over all threads since the last stats_reset()
+FAST_HEX_EXPORT StatsSnapshot stats_snapshot();
+FAST_HEX_EXPORT void stats_reset();
+#endif // defined(FAST_HEX_STATS)
+
 FAST_HEX_NAMESPACE_CLOSE
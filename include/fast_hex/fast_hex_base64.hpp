@@ -0,0 +1,269 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Hex <-> base64 (RFC 4648, standard alphabet, '=' padded) without an intermediate binary buffer.
+//
+// hex_to_base64 decodes the nibbles (unhexBitManip) and regroups every 3 bytes into 4 sextets in the same
+// registers; base64_to_hex does the reverse. The AVX2 kernels take 48 hex digits / 32 base64 characters
+// per iteration, combining decodeHex32Vec or byte2nib + hex<H> with the base64 shuffles of
+// https://github.com/aklomp/base64 (W. Muła's algorithms).
+//
+//   std::vector<uint8_t> b64(heks::base64_size(heks::RawLength{len}));
+//   heks::hex_to_base64(b64.data(), hex, heks::RawLength{len});
+//
+// Like the decoders, hex_to_base64 does not validate its input. base64_to_hex does, and returns false for
+// a length that is not a multiple of 4, characters outside the alphabet or misplaced padding; dest is then
+// unspecified. Non-zero bits below the padding are ignored.
+
+FAST_HEX_NAMESPACE_OPEN
+
+// Number of base64 characters for len raw bytes (2 * len hex digits), padding included
+constexpr size_t base64_size(RawLength len)
+{
+    return (static_cast<size_t>(len) + 2) / 3 * 4;
+}
+
+// Number of raw bytes in the base64 string src of length characters: dest of base64_to_hex needs twice
+// as many bytes. The padding is looked at but not validated.
+constexpr RawLength base64_raw_length(const uint8_t * src, size_t length)
+{
+    if (length == 0 || length % 4 != 0)
+        return RawLength{0};
+    size_t padding = src[length - 1] == '=' ? 1 : 0;
+    if (padding != 0 && src[length - 2] == '=')
+        padding = 2;
+    return RawLength{length / 4 * 3 - padding};
+}
+
+namespace heks_detail
+{
+
+constexpr inline std::string_view base64_alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"sv;
+
+// Character -> sextet, 0xFF for characters outside the alphabet
+constexpr inline auto base64_values = []()
+{
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (size_t i = 0; i < base64_alphabet.size(); ++i)
+        values[static_cast<uint8_t>(base64_alphabet[i])] = static_cast<uint8_t>(i);
+    return values;
+}();
+
+inline uint8_t unhexPair(const uint8_t * src)
+{
+    return static_cast<uint8_t>((unhexBitManip(src[0]) << 4) | unhexBitManip(src[1]));
+}
+
+// 3 bytes in the low 24 bits of group -> 4 base64 characters
+inline void base64Quantum(uint8_t * dest, uint32_t group)
+{
+    dest[0] = static_cast<uint8_t>(base64_alphabet[(group >> 18) & 0x3F]);
+    dest[1] = static_cast<uint8_t>(base64_alphabet[(group >> 12) & 0x3F]);
+    dest[2] = static_cast<uint8_t>(base64_alphabet[(group >> 6) & 0x3F]);
+    dest[3] = static_cast<uint8_t>(base64_alphabet[group & 0x3F]);
+}
+
+// len is number of raw bytes (src holds 2 * len hex digits), returns the number of characters written
+inline size_t hexToBase64Impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    uint8_t * out = dest;
+    for (; i + 3 <= raw_length; i += 3, out += 4)
+    {
+        const uint8_t * hex = src + i * 2;
+        base64Quantum(out, (uint32_t{unhexPair(hex)} << 16) | (uint32_t{unhexPair(hex + 2)} << 8) | unhexPair(hex + 4));
+    }
+    if (i < raw_length)
+    {
+        const uint8_t * hex = src + i * 2;
+        const bool two = raw_length - i == 2;
+        base64Quantum(out, (uint32_t{unhexPair(hex)} << 16) | (two ? uint32_t{unhexPair(hex + 2)} << 8 : 0));
+        out[3] = '=';
+        if (!two)
+            out[2] = '=';
+        out += 4;
+    }
+    return static_cast<size_t>(out - dest);
+}
+
+// Writes the hex digits of the first bytes (3 - padding) of a quantum, returns false if one of its
+// characters is outside the alphabet
+template <HexCase H>
+inline bool base64QuantumToHex(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t padding)
+{
+    const auto & hex_table = (H == HexCase::Lower) ? hex_to_char_lower_sv : hex_to_char_upper_sv;
+    uint32_t group = 0;
+    uint8_t invalid = 0;
+    for (size_t k = 0; k < 4 - padding; ++k)
+    {
+        const uint8_t value = base64_values[src[k]];
+        invalid |= value;
+        group |= uint32_t{value} << (18 - 6 * k);
+    }
+    // Only valid sextets leave the top bits clear
+    if ((invalid & 0xC0) != 0)
+        return false;
+    for (size_t k = 0; k < 3 - padding; ++k)
+        std::memcpy(dest + k * 2, &hex_table[((group >> (16 - 8 * k)) & 0xFF) * 2], 2);
+    return true;
+}
+
+// length is number of base64 characters, dest holds 2 * base64_raw_length(src, length) hex digits
+template <HexCase H>
+bool base64ToHexImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t length)
+{
+    if (length % 4 != 0)
+        return false;
+    if (length == 0)
+        return true;
+    size_t i = 0;
+    for (; i + 4 < length; i += 4)
+        if (!base64QuantumToHex<H>(dest + i / 4 * 6, src + i, 0))
+            return false;
+    // '=' only as the last one or two characters of the string
+    const uint8_t * last = src + i;
+    const size_t padding = last[3] != '=' ? 0 : last[2] != '=' ? 1 : 2;
+    return base64QuantumToHex<H>(dest + i / 4 * 6, last, padding);
+}
+
+#if defined(FAST_HEX_AVX2)
+// 24 bytes (12 per lane, lane 1 from bytes 12-23) -> 32 base64 characters
+__attribute__((target("avx2"))) inline __m256i base64EncodeVec(__m256i in)
+{
+    // 3 bytes [a, b, c] per 32-bit element as [b, a, c, b]; the multiplications move the four sextets
+    // into the low bits of their byte
+    in = _mm256_shuffle_epi8(
+        in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i sextets = _mm256_or_si256(t1, t3);
+
+    // Offset to the character per range: 0-25 'A', 26-51 'a', 52-61 '0', 62 '+', 63 '/'
+    const __m256i offsets = _mm256_setr_epi8(
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0, 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m256i ranges = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    ranges = _mm256_sub_epi8(ranges, _mm256_cmpgt_epi8(sextets, _mm256_set1_epi8(25)));
+    return _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, ranges));
+}
+
+// 32 base64 characters -> 24 bytes, 12 at the start of each lane; false for characters outside the alphabet
+__attribute__((target("avx2"))) inline bool base64DecodeVec(__m256i in, __m256i & out)
+{
+    const __m256i lut_lo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+    // A character is valid when the classes of its low and high nibble do not intersect
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+    const __m256i lo_nibbles = _mm256_and_si256(in, mask_2f);
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    if (!_mm256_testz_si256(lo, hi))
+        return false;
+    const __m256i eq_2f = _mm256_cmpeq_epi8(in, mask_2f);
+    const __m256i sextets = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+
+    // 4 sextets -> 3 bytes per 32-bit element, then 12 bytes per lane
+    const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    out = _mm256_shuffle_epi8(
+        groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    return true;
+}
+
+__attribute__((target("avx2"))) inline size_t
+hexToBase64VecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    // 24 bytes per iteration, from 64 loaded hex digits (32 bytes) of which 48 are used
+    for (; i + 32 <= raw_length; i += 24)
+    {
+        const __m256i bytes = decodeHex32Vec(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2 + 32)));
+        // Bytes 0-11 to lane 0 and 12-23 to lane 1
+        const __m256i lanes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i / 3 * 4), base64EncodeVec(lanes));
+    }
+    return i / 3 * 4 + hexToBase64Impl(dest + i / 3 * 4, src + i * 2, RawLength{raw_length - i});
+}
+
+// 32 base64 characters -> 48 hex digits
+template <HexCase H>
+__attribute__((target("avx2"))) inline bool base64ToHexBlock(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    __m256i bytes;
+    if (!base64DecodeVec(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)), bytes))
+        return false;
+    // Digits of bytes 0-7 / 12-19 and 8-11 / 20-23 (in the low 8 bytes of each lane)
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+    const __m256i lo = _mm256_and_si256(bytes, _mm256_set1_epi8(0x0F));
+    const __m256i first = hex<H>(_mm256_unpacklo_epi8(hi, lo));
+    const __m256i second = hex<H>(_mm256_unpackhi_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm256_castsi256_si128(first));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + 16), _mm256_castsi256_si128(second));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + 24), _mm256_extracti128_si256(first, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + 40), _mm256_extracti128_si256(second, 1));
+    return true;
+}
+
+template <HexCase H>
+__attribute__((target("avx2"))) bool base64ToHexVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t length)
+{
+    if (length % 4 != 0)
+        return false;
+    // The last quantum (maybe padded) is left to the scalar code
+    if (length < 36)
+        return base64ToHexImpl<H>(dest, src, length);
+    const size_t body = length - 4;
+    for (size_t i = 0; i + 32 <= body; i += 32)
+        if (!base64ToHexBlock<H>(dest + i / 4 * 6, src + i))
+            return false;
+    // The rest of the body as one more block, overlapping the previous one
+    if (body % 32 != 0 && !base64ToHexBlock<H>(dest + (body - 32) / 4 * 6, src + body - 32))
+        return false;
+    return base64ToHexImpl<H>(dest + body / 4 * 6, src + body, 4);
+}
+#endif // defined(FAST_HEX_AVX2)
+
+} // namespace heks_detail
+
+// Transcodes the 2 * len hex digits of src into base64_size(len) base64 characters, returns that count
+inline size_t hex_to_base64(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::hexToBase64VecImpl(dest, src, len);
+#else
+    return heks_detail::hexToBase64Impl(dest, src, len);
+#endif
+}
+
+// Transcodes the base64 string src of length characters into 2 * base64_raw_length(src, length) hex digits
+template <class Case>
+bool base64_to_hex(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t length, Case)
+{
+    constexpr auto case_type = Case::value;
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::base64ToHexVecImpl<case_type>(dest, src, length);
+#else
+    return heks_detail::base64ToHexImpl<case_type>(dest, src, length);
+#endif
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// C array literal bodies, as written by `xxd -i` for embedding binary assets in sources:
+//
+//   0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+//   0x49, 0x48, 0x44, 0x52
+//
+// Every line is indented by two spaces and all but the last end with ",\n"; the output is empty for an
+// empty input. The AVX2 and NEON kernels produce "0xab, " for 16 input bytes at a time by shuffling the
+// hex digits (byte2nib + hex<H>) into the 6-byte pattern and or-ing in the fixed characters.
+//
+//   std::vector<uint8_t> out(heks::c_array_size(heks::RawLength{len}));
+//   heks::encodeCArray(out.data(), src, heks::RawLength{len}, heks::lower);
+
+FAST_HEX_NAMESPACE_OPEN
+
+struct CArrayOptions
+{
+    // Items per line, as xxd -i -c (default 12). 0 puts everything on one line.
+    size_t columns = 12;
+    // "0X" instead of "0x", as xxd -i -u writes
+    bool upper_prefix = false;
+};
+
+// Number of bytes written by encodeCArray: 6 per item ("0xab, "), 2 per line for the indentation,
+// minus the comma of the last item
+constexpr size_t c_array_size(RawLength len, const CArrayOptions & options = {})
+{
+    const auto raw_length = static_cast<size_t>(len);
+    if (raw_length == 0)
+        return 0;
+    const size_t columns = options.columns == 0 ? raw_length : options.columns;
+    const size_t lines = (raw_length + columns - 1) / columns;
+    return raw_length * 6 + lines * 2 - 1;
+}
+
+namespace heks_detail
+{
+
+// Shuffle control for N output bytes of "0xab, " items: offsets 2 and 3 of an item take its hex digits,
+// 2 * (p / 6) and the next one, the other offsets 0x80 (zeroed by the shuffle, the fixed characters are
+// or-ed in). The shuffle source advances by WindowStride digits every 32 output bytes.
+template <size_t N, size_t WindowStride>
+constexpr std::array<uint8_t, N> c_array_shuffle()
+{
+    std::array<uint8_t, N> mask{};
+    for (size_t p = 0; p < N; ++p)
+    {
+        const size_t offset = p % 6;
+        if (offset == 2 || offset == 3)
+            mask[p] = static_cast<uint8_t>(2 * (p / 6) + offset - 2 - WindowStride * (p / 32));
+        else
+            mask[p] = 0x80;
+    }
+    return mask;
+}
+
+template <size_t N>
+constexpr std::array<uint8_t, N> c_array_template(char x)
+{
+    std::array<uint8_t, N> chars{};
+    for (size_t p = 0; p < N; ++p)
+    {
+        constexpr char pattern[] = {'0', 'x', 0, 0, ',', ' '};
+        chars[p] = static_cast<uint8_t>(p % 6 == 1 ? x : pattern[p % 6]);
+    }
+    return chars;
+}
+
+// "0xab, "
+template <HexCase H>
+inline void cArrayItem(uint8_t * FAST_HEX_RESTRICT dest, uint8_t value, char x)
+{
+    const auto & hex_table = (H == HexCase::Lower) ? hex_to_char_lower_sv : hex_to_char_upper_sv;
+    dest[0] = '0';
+    dest[1] = static_cast<uint8_t>(x);
+    std::memcpy(dest + 2, &hex_table[static_cast<size_t>(value) * 2], 2);
+    dest[4] = ',';
+    dest[5] = ' ';
+}
+
+// Writes the items of one line. readable is the number of input bytes from src on, and items the number
+// of them on this line; the vector kernels may write up to 15 items past the line when they are
+// followed by at least 16 more input bytes, whose output overwrites the excess.
+template <HexCase H>
+struct CArrayItems
+{
+    static void write(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t items, size_t, char x)
+    {
+        for (size_t i = 0; i < items; ++i)
+            cArrayItem<H>(dest + i * 6, src[i], x);
+    }
+};
+
+#if defined(FAST_HEX_AVX2)
+template <HexCase H>
+struct CArrayItemsVec
+{
+    static constexpr auto shuffle = c_array_shuffle<96, 8>();
+    static constexpr auto lower_x = c_array_template<96>('x');
+    static constexpr auto upper_x = c_array_template<96>('X');
+
+    __attribute__((target("avx2"))) static void
+    write(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t items, size_t readable, char x)
+    {
+        const auto & fixed = x == 'x' ? lower_x : upper_x;
+        __m256i masks[3];
+        __m256i chars[3];
+        for (size_t k = 0; k < 3; ++k)
+        {
+            masks[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(shuffle.data() + k * 32));
+            chars[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(fixed.data() + k * 32));
+        }
+
+        const size_t rounded = (items + 15) / 16 * 16;
+        const size_t vectLen = readable >= rounded + 16 ? rounded : items / 16 * 16;
+        size_t i = 0;
+        for (; i < vectLen; i += 16)
+        {
+            // 32 digits of 16 items; every 32 output bytes take theirs from a window of 16 digits
+            // repeated in both lanes (digits 0-15, 8-23, 16-31), as the shuffle stays within a lane
+            const __m256i digits = hex<H>(byte2nib(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))));
+            const __m256i windows[3] = {
+                _mm256_permute4x64_epi64(digits, 0b01'00'01'00),
+                _mm256_permute4x64_epi64(digits, 0b10'01'10'01),
+                _mm256_permute4x64_epi64(digits, 0b11'10'11'10),
+            };
+            __m256i * out = reinterpret_cast<__m256i *>(dest + i * 6);
+            for (size_t k = 0; k < 3; ++k)
+                _mm256_storeu_si256(out + k, _mm256_or_si256(_mm256_shuffle_epi8(windows[k], masks[k]), chars[k]));
+        }
+        for (; i < items; ++i)
+            cArrayItem<H>(dest + i * 6, src[i], x);
+    }
+};
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+template <HexCase H>
+struct CArrayItemsNeon
+{
+    static constexpr auto shuffle = c_array_shuffle<48, 0>();
+    static constexpr auto lower_x = c_array_template<48>('x');
+    static constexpr auto upper_x = c_array_template<48>('X');
+
+    static void write(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t items, size_t readable, char x)
+    {
+        // clang-format off
+        alignas(16) constexpr uint8_t HEX_LUT_LOWER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+        alignas(16) constexpr uint8_t HEX_LUT_UPPER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+        // clang-format on
+        const uint8x16_t lut = vld1q_u8((H == HexCase::Upper) ? HEX_LUT_UPPER : HEX_LUT_LOWER);
+        const auto & fixed = x == 'x' ? lower_x : upper_x;
+        uint8x16_t masks[3];
+        uint8x16_t chars[3];
+        for (size_t k = 0; k < 3; ++k)
+        {
+            masks[k] = vld1q_u8(shuffle.data() + k * 16);
+            chars[k] = vld1q_u8(fixed.data() + k * 16);
+        }
+
+        const size_t rounded = (items + 15) / 16 * 16;
+        const size_t vectLen = readable >= rounded + 16 ? rounded : items / 16 * 16;
+        size_t i = 0;
+        for (; i < vectLen; i += 16)
+        {
+            const uint8x16_t in = vld1q_u8(src + i);
+            const uint8x16_t hi_chars = neon_tbl_q(lut, vshrq_n_u8(in, 4));
+            const uint8x16_t lo_chars = neon_tbl_q(lut, vandq_u8(in, vdupq_n_u8(0x0F)));
+            // Digits of items 0-7 and 8-15; table lookups with index 0x80 give 0
+            const uint8x16x2_t digits = vzipq_u8(hi_chars, lo_chars);
+            for (size_t half = 0; half < 2; ++half)
+                for (size_t k = 0; k < 3; ++k)
+                    vst1q_u8(dest + i * 6 + half * 48 + k * 16, vorrq_u8(neon_tbl_q(digits.val[half], masks[k]), chars[k]));
+        }
+        for (; i < items; ++i)
+            cArrayItem<H>(dest + i * 6, src[i], x);
+    }
+};
+#endif // FAST_HEX_NEON
+
+template <HexCase H, class Items>
+size_t encodeCArrayImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, const CArrayOptions & options)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    if (raw_length == 0)
+        return 0;
+    const size_t columns = options.columns == 0 ? raw_length : options.columns;
+    const char x = options.upper_prefix ? 'X' : 'x';
+
+    uint8_t * out = dest;
+    size_t done = 0;
+    for (;;)
+    {
+        const size_t line = std::min(columns, raw_length - done);
+        const bool last = done + line == raw_length;
+        *out++ = ' ';
+        *out++ = ' ';
+        // The last item of all goes without the comma
+        const size_t items = last ? line - 1 : line;
+        Items::write(out, src + done, items, raw_length - done, x);
+        out += items * 6;
+        done += items;
+        if (last)
+            break;
+        out[-1] = '\n';
+    }
+    const auto & hex_table = (H == HexCase::Lower) ? hex_to_char_lower_sv : hex_to_char_upper_sv;
+    out[0] = '0';
+    out[1] = static_cast<uint8_t>(x);
+    std::memcpy(out + 2, &hex_table[static_cast<size_t>(src[done]) * 2], 2);
+    out[4] = '\n';
+    return static_cast<size_t>(out + 5 - dest);
+}
+
+} // namespace heks_detail
+
+// Writes src as a C array literal body into dest, which must hold c_array_size(len, options) bytes.
+// Returns the number of bytes written.
+template <class Case>
+size_t encodeCArray(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, Case, const CArrayOptions & options = {})
+{
+    constexpr auto case_type = Case::value;
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::encodeCArrayImpl<case_type, heks_detail::CArrayItemsVec<case_type>>(dest, src, len, options);
+#elif defined(FAST_HEX_NEON)
+    return heks_detail::encodeCArrayImpl<case_type, heks_detail::CArrayItemsNeon<case_type>>(dest, src, len, options);
+#else
+    return heks_detail::encodeCArrayImpl<case_type, heks_detail::CArrayItems<case_type>>(dest, src, len, options);
+#endif
+}
+
+FAST_HEX_NAMESPACE_CLOSE
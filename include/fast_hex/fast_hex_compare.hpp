@@ -0,0 +1,156 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Compares hex digits against binary bytes without decoding them, for digest, ETag or signature checks.
+//
+// The binary side is encoded to lowercase (byte2nib + hex<H>, hexSWAR), the hex side case-folded, and both
+// compared 64 digits at a time with an exit at the first differing block. The fold only touches characters
+// from 0x40 up, so nothing but 'A'-'F' turns into a digit and an invalid character never compares equal:
+// no separate validation pass is needed.
+//
+//   if (heks::hex_equals(etag, digest, heks::RawLength{32})) { ... }
+
+FAST_HEX_NAMESPACE_OPEN
+
+namespace heks_detail
+{
+
+// Returned by the kernels for a character that is not a hex digit before the first difference
+constexpr inline int compare_invalid = 2;
+
+// 'A'-'F' to 'a'-'f': bit 5 set where bit 6 is
+constexpr uint8_t foldHex(uint8_t c)
+{
+    return static_cast<uint8_t>(c | ((c >> 1) & 0x20));
+}
+
+// foldHex on the 8 characters of chars
+constexpr uint64_t foldHexSWAR(uint64_t chars)
+{
+    return chars | ((chars >> 1) & 0x2020202020202020);
+}
+
+// Ordering of a folded hex character against the differing lowercase digit of the binary side; the
+// lowercase digits sort like the nibbles they stand for
+constexpr int compareHexChar(uint8_t folded, uint8_t expected)
+{
+    const bool digit = (folded >= '0' && folded <= '9') || (folded >= 'a' && folded <= 'f');
+    if (!digit)
+        return compare_invalid;
+    return folded < expected ? -1 : 1;
+}
+
+// Scalar / SWAR version: 8 bytes per iteration, then digit by digit from the first differing block.
+// len is number of binary bytes. Returns -1, 0, 1 or compare_invalid.
+inline int compareHexImpl(const uint8_t * FAST_HEX_RESTRICT digits, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 8 <= raw_length; i += 8)
+    {
+        const uint64_t x = loadLE64(bytes + i);
+        if (foldHexSWAR(loadLE64(digits + i * 2)) != hexSWAR<HexCase::Lower>(x & 0xFFFFFFFF)
+            || foldHexSWAR(loadLE64(digits + i * 2 + 8)) != hexSWAR<HexCase::Lower>(x >> 32))
+            break;
+    }
+    for (size_t p = i * 2; p < raw_length * 2; ++p)
+    {
+        const uint8_t folded = foldHex(digits[p]);
+        const auto expected = static_cast<uint8_t>(hex_to_char_lower_sv[static_cast<size_t>(bytes[p / 2]) * 2 + p % 2]);
+        if (folded != expected)
+            return compareHexChar(folded, expected);
+    }
+    return 0;
+}
+
+#if defined(FAST_HEX_AVX2)
+__attribute__((target("avx2"))) inline __m256i foldHex(__m256i chars)
+{
+    // The 16-bit shift moves bit 0 of the next byte into bit 7, which the mask drops
+    return _mm256_or_si256(chars, _mm256_and_si256(_mm256_srli_epi16(chars, 1), _mm256_set1_epi8(0x20)));
+}
+
+// 32 bytes (64 digits) per iteration; the scalar version takes over at the first differing block
+__attribute__((target("avx2"))) inline int
+compareHexVecImpl(const uint8_t * FAST_HEX_RESTRICT digits, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 32 <= raw_length; i += 32)
+    {
+        const __m256i expected1 = hex<HexCase::Lower>(byte2nib(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i))));
+        const __m256i expected2 = hex<HexCase::Lower>(byte2nib(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i + 16))));
+        const __m256i folded1 = foldHex(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(digits + i * 2)));
+        const __m256i folded2 = foldHex(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(digits + i * 2 + 32)));
+        const __m256i equal = _mm256_and_si256(_mm256_cmpeq_epi8(folded1, expected1), _mm256_cmpeq_epi8(folded2, expected2));
+        if (_mm256_movemask_epi8(equal) != -1)
+            break;
+    }
+    return compareHexImpl(digits + i * 2, bytes + i, RawLength{raw_length - i});
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+// 16 bytes (32 digits) per iteration; the scalar version takes over at the first differing block
+inline int compareHexNeonImpl(const uint8_t * FAST_HEX_RESTRICT digits, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+    alignas(16) constexpr uint8_t HEX_LUT_LOWER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    const uint8x16_t lut = vld1q_u8(HEX_LUT_LOWER);
+    const uint8x16_t bit5 = vdupq_n_u8(0x20);
+
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 16 <= raw_length; i += 16)
+    {
+        const uint8x16_t in = vld1q_u8(bytes + i);
+        const uint8x16x2_t expected = vzipq_u8(neon_tbl_q(lut, vshrq_n_u8(in, 4)), neon_tbl_q(lut, vandq_u8(in, vdupq_n_u8(0x0F))));
+        const uint8x16_t chars1 = vld1q_u8(digits + i * 2);
+        const uint8x16_t chars2 = vld1q_u8(digits + i * 2 + 16);
+        const uint8x16_t folded1 = vorrq_u8(chars1, vandq_u8(vshrq_n_u8(chars1, 1), bit5));
+        const uint8x16_t folded2 = vorrq_u8(chars2, vandq_u8(vshrq_n_u8(chars2, 1), bit5));
+        const uint8x16_t equal = vandq_u8(vceqq_u8(folded1, expected.val[0]), vceqq_u8(folded2, expected.val[1]));
+        // A nibble of every byte of the mask in 64 bits (shift right and narrow)
+        if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0) != ~uint64_t{0})
+            break;
+    }
+    return compareHexImpl(digits + i * 2, bytes + i, RawLength{raw_length - i});
+}
+#endif // FAST_HEX_NEON
+
+inline int compareHexAuto(const uint8_t * FAST_HEX_RESTRICT digits, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+#if defined(FAST_HEX_AVX2)
+    return compareHexVecImpl(digits, bytes, len);
+#elif defined(FAST_HEX_NEON)
+    return compareHexNeonImpl(digits, bytes, len);
+#else
+    return compareHexImpl(digits, bytes, len);
+#endif
+}
+
+} // namespace heks_detail
+
+// True if the 2 * len hex digits at hex, in either case, encode the len bytes at bytes. A character that is
+// not a hex digit never matches.
+inline bool hex_equals(const uint8_t * FAST_HEX_RESTRICT hex, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+    return heks_detail::compareHexAuto(hex, bytes, len) == 0;
+}
+
+// Orders the value of the 2 * len hex digits at hex against the len bytes at bytes like memcmp: negative,
+// zero or positive. std::nullopt if a character that is not a hex digit comes before the first
+// difference; the characters after it are not examined.
+inline std::optional<int> hex_compare(const uint8_t * FAST_HEX_RESTRICT hex, const uint8_t * FAST_HEX_RESTRICT bytes, RawLength len)
+{
+    const int result = heks_detail::compareHexAuto(hex, bytes, len);
+    if (result == heks_detail::compare_invalid)
+        return std::nullopt;
+    return result;
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE4_2__)
+#    include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#    include <arm_acle.h>
+#endif
+
+// Hex encoding and decoding fused with a CRC32C (Castagnoli, as used by iSCSI, ext4 or RocksDB) of the
+// binary side, for records stored as hex with a checksum trailer: one pass over the data instead of two.
+//
+// The checksum is taken 8 bytes at a time from the registers the kernels already hold: the SSE4.2 crc32
+// instruction on x86, the ARMv8 CRC32 extension (__ARM_FEATURE_CRC32) on ARM, and a slicing-by-8 table
+// otherwise. Like zlib's crc32(), the functions take the checksum of the preceding data to continue from
+// (0 to start) and return the updated one.
+//
+//   const uint32_t crc = heks::encodeHexCrc32c(dest, record, heks::RawLength{len}, heks::lower);
+//   if (heks::decodeHexCrc32c(binary, dest, heks::RawLength{len}) != crc) { ... }
+
+FAST_HEX_NAMESPACE_OPEN
+
+namespace heks_detail
+{
+
+// Slicing-by-8 tables of the reflected polynomial 0x82F63B78: crc32c_tables[k][b] is the CRC state
+// change of byte b followed by k zero bytes
+constexpr inline auto crc32c_tables = []()
+{
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t b = 0; b < 256; ++b)
+    {
+        uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0x82F63B78 : 0);
+        tables[0][b] = crc;
+    }
+    for (size_t k = 1; k < 8; ++k)
+        for (size_t b = 0; b < 256; ++b)
+            tables[k][b] = (tables[k - 1][b] >> 8) ^ tables[0][tables[k - 1][b] & 0xFF];
+    return tables;
+}();
+
+// The 8 bytes of word, first byte in the low bits (loadLE64)
+constexpr uint32_t crc32cWordTable(uint32_t state, uint64_t word)
+{
+    const auto & t = crc32c_tables;
+    const uint32_t lo = state ^ static_cast<uint32_t>(word);
+    const auto hi = static_cast<uint32_t>(word >> 32);
+    return t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF]
+        ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+}
+
+constexpr uint32_t crc32cByteTable(uint32_t state, uint8_t byte)
+{
+    return (state >> 8) ^ crc32c_tables[0][(state ^ byte) & 0xFF];
+}
+
+inline uint32_t crc32cWord(uint32_t state, uint64_t word)
+{
+#if defined(__SSE4_2__)
+    return static_cast<uint32_t>(_mm_crc32_u64(state, word));
+#elif defined(__ARM_FEATURE_CRC32)
+    return __crc32cd(state, word);
+#else
+    return crc32cWordTable(state, word);
+#endif
+}
+
+inline uint32_t crc32cByte(uint32_t state, uint8_t byte)
+{
+#if defined(__SSE4_2__)
+    return _mm_crc32_u8(state, byte);
+#elif defined(__ARM_FEATURE_CRC32)
+    return __crc32cb(state, byte);
+#else
+    return crc32cByteTable(state, byte);
+#endif
+}
+
+// state is the inverted checksum, as the crc32 instruction keeps it
+inline uint32_t crc32cUpdate(uint32_t state, const uint8_t * data, size_t size)
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+        state = crc32cWord(state, loadLE64(data + i));
+    for (; i < size; ++i)
+        state = crc32cByte(state, data[i]);
+    return state;
+}
+
+// Scalar / SWAR versions: 8 bytes per iteration. len is number of binary bytes, state as crc32cUpdate.
+template <HexCase H>
+uint32_t encodeHexCrc32cImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t state)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 8 <= raw_length; i += 8)
+    {
+        const uint64_t x = loadLE64(src + i);
+        storeLE64(dest + i * 2, hexSWAR<H>(x & 0xFFFFFFFF));
+        storeLE64(dest + i * 2 + 8, hexSWAR<H>(x >> 32));
+        state = crc32cWord(state, x);
+    }
+    encodeHexImpl<H>(dest + i * 2, src + i, RawLength{raw_length - i});
+    return crc32cUpdate(state, src + i, raw_length - i);
+}
+
+inline uint32_t decodeHexCrc32cImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t state)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 8 <= raw_length; i += 8)
+    {
+        const uint64_t x = unhexSWAR(loadLE64(src + i * 2)) | (unhexSWAR(loadLE64(src + i * 2 + 8)) << 32);
+        storeLE64(dest + i, x);
+        state = crc32cWord(state, x);
+    }
+    decodeHexBMIImpl(dest + i, src + i * 2, RawLength{raw_length - i});
+    return crc32cUpdate(state, dest + i, raw_length - i);
+}
+
+#if defined(FAST_HEX_AVX2) && defined(__SSE4_2__)
+// 32 bytes per iteration, the checksum taken from the two 16-byte halves held for byte2nib
+template <HexCase H>
+__attribute__((target("avx2"))) uint32_t
+encodeHexCrc32cVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t state)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 32 <= raw_length; i += 32)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i * 2), hex<H>(byte2nib(a)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i * 2 + 32), hex<H>(byte2nib(b)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_cvtsi128_si64(a)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_extract_epi64(a, 1)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_cvtsi128_si64(b)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_extract_epi64(b, 1)));
+    }
+    return encodeHexCrc32cImpl<H>(dest + i * 2, src + i, RawLength{raw_length - i}, state);
+}
+
+// 64 hex digits -> 32 bytes per iteration, the checksum taken from the decoded register
+__attribute__((target("avx2"))) inline uint32_t
+decodeHexCrc32cVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t state)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 32 <= raw_length; i += 32)
+    {
+        const __m256i bytes = decodeHex32Vec(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2 + 32)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), bytes);
+        const __m128i a = _mm256_castsi256_si128(bytes);
+        const __m128i b = _mm256_extracti128_si256(bytes, 1);
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_cvtsi128_si64(a)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_extract_epi64(a, 1)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_cvtsi128_si64(b)));
+        state = crc32cWord(state, static_cast<uint64_t>(_mm_extract_epi64(b, 1)));
+    }
+    return decodeHexCrc32cImpl(dest + i, src + i * 2, RawLength{raw_length - i}, state);
+}
+#endif // defined(FAST_HEX_AVX2) && defined(__SSE4_2__)
+
+#if defined(FAST_HEX_NEON)
+// 16 bytes per iteration, the checksum taken from the two lanes of the input vector
+template <HexCase H>
+uint32_t encodeHexCrc32cNeonImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t state)
+{
+    // clang-format off
+    alignas(16) constexpr uint8_t HEX_LUT_LOWER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    alignas(16) constexpr uint8_t HEX_LUT_UPPER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    // clang-format on
+    const uint8x16_t lut = vld1q_u8((H == HexCase::Upper) ? HEX_LUT_UPPER : HEX_LUT_LOWER);
+
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 16 <= raw_length; i += 16)
+    {
+        const uint8x16_t in = vld1q_u8(src + i);
+        const uint8x16_t hi_chars = neon_tbl_q(lut, vshrq_n_u8(in, 4));
+        const uint8x16_t lo_chars = neon_tbl_q(lut, vandq_u8(in, vdupq_n_u8(0x0F)));
+        const uint8x16x2_t interleaved = vzipq_u8(hi_chars, lo_chars);
+        vst1q_u8(dest + i * 2, interleaved.val[0]);
+        vst1q_u8(dest + i * 2 + 16, interleaved.val[1]);
+        const uint64x2_t words = vreinterpretq_u64_u8(in);
+        state = crc32cWord(state, vgetq_lane_u64(words, 0));
+        state = crc32cWord(state, vgetq_lane_u64(words, 1));
+    }
+    return encodeHexCrc32cImpl<H>(dest + i * 2, src + i, RawLength{raw_length - i}, state);
+}
+#endif // FAST_HEX_NEON
+
+} // namespace heks_detail
+
+// CRC32C of size bytes, continuing from the checksum crc of the preceding data (0 to start)
+inline uint32_t crc32c(const uint8_t * data, size_t size, uint32_t crc = 0)
+{
+    return ~heks_detail::crc32cUpdate(~crc, data, size);
+}
+
+// Encodes src like encode_auto and returns the CRC32C of its len bytes, continuing from crc
+template <class Case>
+uint32_t encodeHexCrc32c(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, Case, uint32_t crc = 0)
+{
+    constexpr auto case_type = Case::value;
+#if defined(FAST_HEX_AVX2) && defined(__SSE4_2__)
+    return ~heks_detail::encodeHexCrc32cVecImpl<case_type>(dest, src, len, ~crc);
+#elif defined(FAST_HEX_NEON)
+    return ~heks_detail::encodeHexCrc32cNeonImpl<case_type>(dest, src, len, ~crc);
+#else
+    return ~heks_detail::encodeHexCrc32cImpl<case_type>(dest, src, len, ~crc);
+#endif
+}
+
+// Decodes src like decode_auto (len is number of dest bytes) and returns the CRC32C of the decoded bytes,
+// continuing from crc
+inline uint32_t decodeHexCrc32c(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len, uint32_t crc = 0)
+{
+#if defined(FAST_HEX_AVX2) && defined(__SSE4_2__)
+    return ~heks_detail::decodeHexCrc32cVecImpl(dest, src, len, ~crc);
+#else
+    return ~heks_detail::decodeHexCrc32cImpl(dest, src, len, ~crc);
+#endif
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#    error "fast_hex_file.hpp requires POSIX mmap"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Whole-file encoding and decoding through memory mappings.
+//
+// The input is mapped read-only (MADV_SEQUENTIAL), the output is sized with ftruncate and mapped
+// writable, and encode_auto/decode_auto run directly between the two mappings: no intermediate heap
+// buffer and no read()/write() copies.
+//
+//   if (auto ec = heks::encode_file("blob.bin", "blob.hex", heks::lower))
+//       std::fprintf(stderr, "%s\n", ec.message().c_str());
+//
+// The output holds the bare hex digits (no newlines). Like the other decoders, decode_file does not
+// validate its input; an odd input size is reported as std::errc::invalid_argument. The output is
+// replaced, and may be left partially written on error.
+
+FAST_HEX_NAMESPACE_OPEN
+
+struct FileOptions
+{
+    // MADV_HUGEPAGE on both mappings. A hint: only effective where the kernel backs file mappings
+    // with huge pages (e.g. tmpfs with huge=advise), ignored otherwise.
+    bool huge_pages = false;
+    // When non-zero, the output is written back with msync(MS_SYNC) after every sync_chunk output
+    // bytes (rounded up to whole pages) and at the end. This bounds the dirty pages of a multi-GB
+    // output and makes the file durable on return. 0 leaves writeback to the kernel, as write() does.
+    size_t sync_chunk = 0;
+};
+
+namespace heks_detail
+{
+
+inline std::error_code last_error()
+{
+    return {errno, std::generic_category()};
+}
+
+class FileHandle
+{
+public:
+    FileHandle(const char * path, int flags, mode_t mode = 0)
+    {
+        do
+            fd_ = ::open(path, flags | O_CLOEXEC, mode);
+        while (fd_ < 0 && errno == EINTR);
+    }
+    ~FileHandle()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+    FileHandle(const FileHandle &) = delete;
+    FileHandle & operator=(const FileHandle &) = delete;
+
+    int get() const { return fd_; }
+
+private:
+    int fd_ = -1;
+};
+
+class FileMapping
+{
+public:
+    FileMapping(int fd, size_t size, int prot)
+        : size_(size)
+    {
+        void * p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        data_ = p == MAP_FAILED ? nullptr : static_cast<uint8_t *>(p);
+    }
+    ~FileMapping()
+    {
+        if (data_ != nullptr)
+            ::munmap(data_, size_);
+    }
+    FileMapping(const FileMapping &) = delete;
+    FileMapping & operator=(const FileMapping &) = delete;
+
+    uint8_t * data() const { return data_; }
+
+    void advise(const FileOptions & options) const
+    {
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+        if (options.huge_pages)
+            ::madvise(data_, size_, MADV_HUGEPAGE);
+#else
+        static_cast<void>(options);
+#endif
+    }
+
+    std::error_code sync(size_t offset, size_t length) const
+    {
+        // msync needs a page aligned start
+        const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t start = offset / page * page;
+        if (::msync(data_ + start, offset + length - start, MS_SYNC) != 0)
+            return last_error();
+        return {};
+    }
+
+private:
+    uint8_t * data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Maps in_path and an output of out_size(input size) bytes at out_path, then calls
+// step(dest, src, raw_length) over the input, in chunks when the output is synced as it goes.
+// in_ratio / out_ratio are the bytes per raw byte on each side (2 and 1 for encoding).
+template <typename OutSize, typename Step>
+std::error_code transform_file(const char * in_path, const char * out_path, const FileOptions & options, size_t in_ratio, size_t out_ratio, OutSize out_size, Step step)
+{
+    FileHandle in(in_path, O_RDONLY);
+    if (in.get() < 0)
+        return last_error();
+    struct stat in_stat{};
+    if (::fstat(in.get(), &in_stat) != 0)
+        return last_error();
+    // Pipes and devices have no size to map
+    if (!S_ISREG(in_stat.st_mode))
+        return std::make_error_code(std::errc::invalid_argument);
+    const auto in_size = static_cast<size_t>(in_stat.st_size);
+    size_t size = 0;
+    if (const auto ec = out_size(in_size, size))
+        return ec;
+
+    // No O_TRUNC before making sure the output is not the input
+    FileHandle out(out_path, O_RDWR | O_CREAT, 0666);
+    if (out.get() < 0)
+        return last_error();
+    struct stat out_stat{};
+    if (::fstat(out.get(), &out_stat) != 0)
+        return last_error();
+    if (out_stat.st_dev == in_stat.st_dev && out_stat.st_ino == in_stat.st_ino)
+        return std::make_error_code(std::errc::invalid_argument);
+    if (::ftruncate(out.get(), 0) != 0 || ::ftruncate(out.get(), static_cast<off_t>(size)) != 0)
+        return last_error();
+    if (size == 0)
+        return {};
+#if defined(__linux__)
+    // Reserve the blocks: running out of space while storing through a mapping raises SIGBUS
+    if (::fallocate(out.get(), 0, 0, static_cast<off_t>(size)) != 0 && errno != EOPNOTSUPP && errno != ENOSYS)
+        return last_error();
+#endif
+
+    const FileMapping src(in.get(), in_size, PROT_READ);
+    if (src.data() == nullptr)
+        return last_error();
+    const FileMapping dest(out.get(), size, PROT_READ | PROT_WRITE);
+    if (dest.data() == nullptr)
+        return last_error();
+    src.advise(options);
+    dest.advise(options);
+
+    const size_t raw_size = size / out_ratio;
+    if (options.sync_chunk == 0)
+    {
+        step(dest.data(), src.data(), RawLength{raw_size});
+        return {};
+    }
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t chunk = std::max<size_t>(1, (options.sync_chunk + page - 1) / page * page / out_ratio);
+    for (size_t done = 0; done < raw_size; done += chunk)
+    {
+        const size_t n = std::min(chunk, raw_size - done);
+        step(dest.data() + done * out_ratio, src.data() + done * in_ratio, RawLength{n});
+        if (const auto ec = dest.sync(done * out_ratio, n * out_ratio))
+            return ec;
+    }
+    return {};
+}
+
+} // namespace heks_detail
+
+// Encode the file at in_path into hex digits at out_path (2 bytes per input byte)
+template <class Case>
+std::error_code encode_file(const char * in_path, const char * out_path, Case, const FileOptions & options = {})
+{
+    auto out_size = [](size_t in_size, size_t & size) -> std::error_code
+    {
+        if (in_size > std::numeric_limits<size_t>::max() / 2)
+            return std::make_error_code(std::errc::file_too_large);
+        size = in_size * 2;
+        return {};
+    };
+    auto step = [](uint8_t * d, const uint8_t * s, RawLength n) { encode_auto(d, s, n, Case{}); };
+    return heks_detail::transform_file(in_path, out_path, options, 1, 2, out_size, step);
+}
+
+// Decode the hex digits of the file at in_path into out_path (1 byte per 2 input bytes)
+inline std::error_code decode_file(const char * in_path, const char * out_path, const FileOptions & options = {})
+{
+    auto out_size = [](size_t in_size, size_t & size) -> std::error_code
+    {
+        if (in_size % 2 != 0)
+            return std::make_error_code(std::errc::invalid_argument);
+        size = in_size / 2;
+        return {};
+    };
+    auto step = [](uint8_t * d, const uint8_t * s, RawLength n) { decode_auto(d, s, n); };
+    return heks_detail::transform_file(in_path, out_path, options, 2, 1, out_size, step);
+}
+
+FAST_HEX_NAMESPACE_CLOSE
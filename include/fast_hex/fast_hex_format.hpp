@@ -0,0 +1,262 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#    include <format>
+#endif
+#if __has_include(<fmt/format.h>) && !defined(FAST_HEX_NO_FMT)
+#    include <fmt/format.h>
+#    define FAST_HEX_HAVE_FMT 1
+#endif
+
+// std::format and fmt formatting of byte spans as hex, encoded with encode_auto instead of a format call
+// per byte. The digits are encoded into 4 KiB blocks on the stack. With fmt each block is written as a
+// string_view, which fmt appends to its buffer in bulk; std::format gets them copied to its output iterator.
+//
+//   fmt::print("key={}\n", heks::hex_view(key, 32));
+//   std::format("{::X}", heks::hex_view(mac, 6));    // 00:1A:2B:3C:4D:5E
+//
+// Format spec: [[group] separator] ['.' bytes] ['x' | 'X']
+//   separator  character put between groups of group bytes (1 if not given), e.g. {::} or {4 }
+//   .bytes     only the first bytes of the span are formatted, e.g. {:.16} for at most 32 digits
+//   x / X      lowercase / uppercase digits, default the case of the view
+// The fmt formatter is defined if <fmt/format.h> can be included (and FAST_HEX_NO_FMT is not defined).
+
+FAST_HEX_NAMESPACE_OPEN
+
+// Bytes to format as hex, with their default case and separator (the format spec overrides them)
+struct hex_view
+{
+    const uint8_t * data = nullptr;
+    size_t size = 0;
+    heks_detail::HexCase hex_case = heks_detail::HexCase::Lower;
+    // Put between every group bytes, no separator if '\0'
+    char separator = '\0';
+    size_t group = 1;
+
+    constexpr hex_view() = default;
+
+    template <class Case = lower_t, class = decltype(Case::value)>
+    constexpr hex_view(const uint8_t * bytes, size_t length, Case = {}, char sep = '\0', size_t group_bytes = 1)
+        : data(bytes)
+        , size(length)
+        , hex_case(Case::value)
+        , separator(sep)
+        , group(group_bytes)
+    {
+    }
+
+    template <class Case = lower_t, class = decltype(Case::value)>
+    constexpr hex_view(std::span<const uint8_t> bytes, Case = {}, char sep = '\0', size_t group_bytes = 1)
+        : hex_view(bytes.data(), bytes.size(), Case{}, sep, group_bytes)
+    {
+    }
+};
+
+namespace heks_detail
+{
+
+// What a format spec sets; the rest comes from the view
+struct HexFormatSpec
+{
+    bool has_case = false;
+    HexCase hex_case = HexCase::Lower;
+    bool has_separator = false;
+    char separator = '\0';
+    size_t group = 1;
+    size_t max_bytes = static_cast<size_t>(-1);
+};
+
+struct HexFormat
+{
+    HexCase hex_case;
+    char separator;
+    size_t group;
+};
+
+inline constexpr size_t hex_format_block = 4096;
+
+// Parses [[group] separator] ['.' bytes] ['x' | 'X'] from it. Returns the position of the closing '}' (or
+// end), with ok false if the spec is malformed.
+template <class It>
+constexpr It parseHexFormatSpec(It it, It end, HexFormatSpec & spec, bool & ok)
+{
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    const auto parse_number = [&](size_t & value)
+    {
+        value = 0;
+        for (; it != end && is_digit(*it); ++it)
+            value = value * 10 + static_cast<size_t>(*it - '0');
+    };
+    ok = false;
+
+    if (it != end && is_digit(*it))
+    {
+        parse_number(spec.group);
+        if (spec.group == 0 || it == end || *it == '}' || *it == '{' || *it == '.' || *it == 'x' || *it == 'X')
+            return it;
+        spec.has_separator = true;
+        spec.separator = *it++;
+    }
+    else if (it != end && *it != '}' && *it != '{' && *it != '.' && *it != 'x' && *it != 'X')
+    {
+        spec.has_separator = true;
+        spec.separator = *it++;
+    }
+    if (it != end && *it == '.')
+    {
+        ++it;
+        if (it == end || !is_digit(*it))
+            return it;
+        parse_number(spec.max_bytes);
+    }
+    if (it != end && (*it == 'x' || *it == 'X'))
+    {
+        spec.has_case = true;
+        spec.hex_case = *it++ == 'x' ? HexCase::Lower : HexCase::Upper;
+    }
+    ok = it == end || *it == '}';
+    return it;
+}
+
+constexpr HexFormat resolveHexFormat(const hex_view & view, const HexFormatSpec & spec)
+{
+    const bool separated = spec.has_separator ? spec.separator != '\0' : view.separator != '\0';
+    return HexFormat{
+        spec.has_case ? spec.hex_case : view.hex_case,
+        spec.has_separator ? spec.separator : view.separator,
+        separated ? std::max<size_t>(spec.has_separator ? spec.group : view.group, 1) : 1,
+    };
+}
+
+inline void encodeHexChars(char * dest, const uint8_t * src, size_t count, HexCase hex_case)
+{
+    auto * out = reinterpret_cast<uint8_t *>(dest);
+    if (hex_case == HexCase::Lower)
+        encode_auto(out, src, RawLength{count}, lower);
+    else
+        encode_auto(out, src, RawLength{count}, upper);
+}
+
+// Writes count bytes from src, byte index of the whole view, with the separator in front of every group
+// but the first. Returns the end of the output.
+inline char * writeHexGroups(char * dest, const uint8_t * src, size_t index, size_t count, const HexFormat & format)
+{
+    if (format.separator == '\0')
+    {
+        encodeHexChars(dest, src, count, format.hex_case);
+        return dest + count * 2;
+    }
+    char digits[hex_format_block];
+    for (size_t done = 0; done < count;)
+    {
+        const size_t chunk = std::min(count - done, sizeof(digits) / 2);
+        encodeHexChars(digits, src + done, chunk, format.hex_case);
+        // Whole runs of digits up to the next group boundary
+        for (size_t k = 0; k < chunk;)
+        {
+            const size_t position = index + done + k;
+            if (position != 0 && position % format.group == 0)
+                *dest++ = format.separator;
+            const size_t run = std::min(chunk - k, format.group - position % format.group);
+            std::memcpy(dest, digits + k * 2, run * 2);
+            dest += run * 2;
+            k += run;
+        }
+        done += chunk;
+    }
+    return dest;
+}
+
+// writeHexGroups into a 4 KiB block on the stack, handed to write(block, size) once per block
+template <class Write>
+void formatHexBlocks(const uint8_t * src, size_t count, const HexFormat & format, Write && write)
+{
+    char block[hex_format_block];
+    // A separator after every byte at most: 3 characters per byte
+    const size_t step = format.separator == '\0' ? sizeof(block) / 2 : sizeof(block) / 3;
+    for (size_t i = 0; i < count; i += step)
+    {
+        const size_t chunk = std::min(step, count - i);
+        write(block, static_cast<size_t>(writeHexGroups(block, src + i, i, chunk, format) - block));
+    }
+}
+
+} // namespace heks_detail
+
+FAST_HEX_NAMESPACE_CLOSE
+
+// The formatters are specialized outside of the library namespace, if any
+#if defined(FAST_HEX_USE_NAMESPACE) && FAST_HEX_USE_NAMESPACE
+#    define FAST_HEX_FORMAT_NS heks::
+#else
+#    define FAST_HEX_FORMAT_NS ::
+#endif
+
+#if defined(__cpp_lib_format)
+template <>
+struct std::formatter<FAST_HEX_FORMAT_NS hex_view, char>
+{
+    constexpr auto parse(std::format_parse_context & ctx)
+    {
+        bool ok = false;
+        const auto it = FAST_HEX_FORMAT_NS heks_detail::parseHexFormatSpec(ctx.begin(), ctx.end(), spec, ok);
+        if (!ok)
+            throw std::format_error("invalid hex format spec");
+        return it;
+    }
+
+    template <class FormatContext>
+    auto format(const FAST_HEX_FORMAT_NS hex_view & view, FormatContext & ctx) const
+    {
+        const auto format = FAST_HEX_FORMAT_NS heks_detail::resolveHexFormat(view, spec);
+        const size_t count = std::min(view.size, spec.max_bytes);
+        // The output iterator of std::format does not expose its buffer
+        auto out = ctx.out();
+        FAST_HEX_FORMAT_NS heks_detail::formatHexBlocks(
+            view.data, count, format, [&](const char * block, size_t size) { out = std::copy_n(block, size, out); });
+        return out;
+    }
+
+    FAST_HEX_FORMAT_NS heks_detail::HexFormatSpec spec;
+};
+#endif // defined(__cpp_lib_format)
+
+#if defined(FAST_HEX_HAVE_FMT)
+template <>
+struct fmt::formatter<FAST_HEX_FORMAT_NS hex_view>
+{
+    constexpr auto parse(fmt::format_parse_context & ctx)
+    {
+        bool ok = false;
+        const auto it = FAST_HEX_FORMAT_NS heks_detail::parseHexFormatSpec(ctx.begin(), ctx.end(), spec, ok);
+        if (!ok)
+            throw fmt::format_error("invalid hex format spec");
+        return it;
+    }
+
+    template <class FormatContext>
+    auto format(const FAST_HEX_FORMAT_NS hex_view & view, FormatContext & ctx) const
+    {
+        const auto format = FAST_HEX_FORMAT_NS heks_detail::resolveHexFormat(view, spec);
+        const size_t count = std::min(view.size, spec.max_bytes);
+        // Each block is appended as a string_view: fmt copies it into its buffer in bulk, through the public API
+        auto out = ctx.out();
+        FAST_HEX_FORMAT_NS heks_detail::formatHexBlocks(view.data, count, format, [&](const char * block, size_t size)
+                                                        { out = fmt::format_to(out, "{}", fmt::string_view(block, size)); });
+        return out;
+    }
+
+    FAST_HEX_FORMAT_NS heks_detail::HexFormatSpec spec;
+};
+#endif // defined(FAST_HEX_HAVE_FMT)
+
+#undef FAST_HEX_FORMAT_NS
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string_view>
+#include <utility>
 
 #if defined(FAST_HEX_AVX2) || defined(FAST_HEX_AVX)
 #    if defined(__GNUC__)
@@ -18,6 +19,11 @@
 #    include <arm_neon.h>
 #endif
 
+#if defined(FAST_HEX_TUNING)
+#    include <algorithm>
+#    include <atomic>
+#endif
+
 #if defined(_MSC_VER)
 #    define FAST_HEX_RESTRICT __restrict // The C99 keyword, available as a C++ extension
 #else
@@ -40,6 +46,15 @@
 #    define FAST_HEX_FUNCTION_INLINE inline
 #endif
 
+// Hot-path statistics, see stats_snapshot(). Compiles to nothing unless FAST_HEX_STATS is defined.
+#if defined(FAST_HEX_STATS)
+#    include <atomic>
+#    include "fast_hex_stats.hpp"
+#    define FAST_HEX_STAT(path, len) heks_detail::stats_record(StatsPath::path, static_cast<size_t>(len))
+#else
+#    define FAST_HEX_STAT(path, len) static_cast<void>(0)
+#endif
+
 #if defined(_MSC_VER)
 #    define FAST_HEX_BSWAP64(x) _byteswap_uint64(x)
 #else
@@ -74,6 +89,8 @@ void encodeHexUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_R
 #if defined(FAST_HEX_AVX)
 void encodeHex8LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 void encodeHex8UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex8Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex16Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif // defined(FAST_HEX_AVX)
 
 #if defined(FAST_HEX_AVX2)
@@ -83,6 +100,7 @@ void encodeHexLowerVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HE
 void encodeHexUpperVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 void encodeHex16LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 void encodeHex16UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex32Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif // defined(FAST_HEX_AVX2)
 
 #if defined(FAST_HEX_NEON)
@@ -90,14 +108,102 @@ void encodeHexNeonLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_H
 void encodeHexNeonUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len);
 void encodeHex16LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 void encodeHex16UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex8Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex16Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
+void decodeHex32Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src);
 #endif // FAST_HEX_NEON
 
+#if defined(FAST_HEX_STATS)
+StatsSnapshot stats_snapshot();
+void stats_reset();
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 
 namespace heks_detail
 {
 using namespace std::literals::string_view_literals;
 
+#if defined(FAST_HEX_STATS)
+// Counters are only written by the owning thread (relaxed load + store, no locked RMW) and read by
+// stats_snapshot() from any thread.
+struct StatsCounters
+{
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> sizes[stats_size_buckets]{};
+};
+
+struct StatsCounterSet
+{
+    StatsCounters paths[stats_path_count];
+};
+
+// One per thread, padded to a cache line. Blocks are never freed: the counters of exited threads keep
+// contributing to snapshots and the block is handed to the next new thread.
+struct alignas(64) StatsBlock : StatsCounterSet
+{
+    std::atomic<bool> in_use{true};
+    StatsBlock * next = nullptr;
+};
+
+inline std::atomic<StatsBlock *> stats_blocks{nullptr};
+// Totals at the last stats_reset()
+inline StatsCounterSet stats_baseline;
+
+inline StatsBlock * stats_acquire_block()
+{
+    for (auto * block = stats_blocks.load(std::memory_order_acquire); block != nullptr; block = block->next)
+    {
+        bool expected = false;
+        if (block->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return block;
+    }
+    auto * block = new StatsBlock;
+    block->next = stats_blocks.load(std::memory_order_relaxed);
+    while (!stats_blocks.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+    return block;
+}
+
+struct StatsThread
+{
+    StatsBlock * block = stats_acquire_block();
+    ~StatsThread() { block->in_use.store(false, std::memory_order_release); }
+};
+
+inline void stats_add(std::atomic<uint64_t> & counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void stats_record(StatsPath path, size_t raw_length)
+{
+    thread_local StatsThread thread;
+    auto & counters = thread.block->paths[static_cast<size_t>(path)];
+    stats_add(counters.calls, 1);
+    stats_add(counters.bytes, raw_length);
+    stats_add(counters.sizes[stats_size_bucket(raw_length)], 1);
+}
+
+inline void stats_collect(StatsSnapshot & snapshot)
+{
+    for (auto * block = stats_blocks.load(std::memory_order_acquire); block != nullptr; block = block->next)
+    {
+        for (size_t path = 0; path < stats_path_count; ++path)
+        {
+            const auto & counters = block->paths[path];
+            auto & entry = snapshot.paths[path];
+            entry.calls += counters.calls.load(std::memory_order_relaxed);
+            entry.bytes += counters.bytes.load(std::memory_order_relaxed);
+            for (size_t bucket = 0; bucket < stats_size_buckets; ++bucket)
+                entry.sizes[bucket] += counters.sizes[bucket].load(std::memory_order_relaxed);
+        }
+    }
+}
+#endif // defined(FAST_HEX_STATS)
+
 enum class HexCase
 {
     Lower,
@@ -359,6 +465,73 @@ inline void encodeHexImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST
     }
 }
 
+// UTF-16 (char16_t) or UTF-32 (char32_t) output, len is number of src bytes
+template <HexCase H, typename CharT>
+inline void encodeHexWideImpl(CharT * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto & hex_table = (H == HexCase::Lower) ? hex_to_char_lower_sv : hex_to_char_upper_sv;
+
+    const auto raw_length = static_cast<size_t>(len);
+    for (size_t i = 0; i < raw_length; i++)
+    {
+        const char * pair = &hex_table[static_cast<size_t>(src[i]) * 2];
+        dest[i * 2] = static_cast<CharT>(pair[0]);
+        dest[i * 2 + 1] = static_cast<CharT>(pair[1]);
+    }
+}
+
+// SWAR (SIMD within a register) kernels: plain 64-bit arithmetic, no tables. Lanes are in memory
+// order (the first byte in the low bits) on any host.
+inline uint64_t loadLE64(const uint8_t * src)
+{
+    uint64_t value;
+    std::memcpy(&value, src, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big)
+        value = FAST_HEX_BSWAP64(value);
+    return value;
+}
+
+inline void storeLE64(uint8_t * dest, uint64_t value)
+{
+    if constexpr (std::endian::native == std::endian::big)
+        value = FAST_HEX_BSWAP64(value);
+    std::memcpy(dest, &value, sizeof(value));
+}
+
+// The low 4 bytes of x to their 8 hex characters
+template <HexCase H>
+constexpr uint64_t hexSWAR(uint64_t x)
+{
+    // One byte per 16-bit lane, then its high nibble in the low byte of the lane (it comes first)
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFF;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FF;
+    const uint64_t nibbles = ((x >> 4) & 0x000F000F000F000F) | ((x & 0x000F000F000F000F) << 8);
+    // '0' + nibble, plus the distance to the letters for nibbles above 9 (nibble + 6 carries into bit 4)
+    const uint64_t above9 = ((nibbles + 0x0606060606060606) >> 4) & 0x0101010101010101;
+    constexpr uint64_t letters = (H == HexCase::Lower ? 'a' : 'A') - '0' - 10;
+    return nibbles + 0x3030303030303030 + above9 * letters;
+}
+
+// len is number of src bytes
+template <HexCase H>
+inline void encodeHexSWARImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 8 <= raw_length; i += 8)
+    {
+        const uint64_t x = loadLE64(src + i);
+        storeLE64(dest + i * 2, hexSWAR<H>(x & 0xFFFFFFFF));
+        storeLE64(dest + i * 2 + 8, hexSWAR<H>(x >> 32));
+    }
+    for (uint8_t * out = dest + i * 2; i < raw_length; i++, out += 2)
+    {
+        const uint64_t chars = hexSWAR<H>(src[i]);
+        out[0] = static_cast<uint8_t>(chars);
+        out[1] = static_cast<uint8_t>(chars >> 8);
+    }
+}
+
 #if defined(FAST_HEX_AVX)
 
 template <HexCase H>
@@ -400,6 +573,8 @@ encodeHexVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_REST
         _mm256_storeu_si256(&output256[i], hexed);
     }
 
+    if (tailLen > 0)
+        FAST_HEX_STAT(EncodeHexVecTail, tailLen);
     encodeHexImpl<H>(dest + (vectLen << 5), src + (vectLen << 4), RawLength{tailLen});
 }
 
@@ -422,6 +597,54 @@ __attribute__((target("avx2"))) inline void encodeHex16Fast(uint8_t * FAST_HEX_R
     // Store all 32 bytes (16 input → 32 hex chars)
     _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), hexed);
 }
+
+// Zero-extends 32 ASCII characters to char16_t (2 stores) or char32_t (4 stores)
+template <typename CharT>
+__attribute__((target("avx2"))) inline void storeWidened(CharT * dest, __m256i chars)
+{
+    const __m128i lo = _mm256_castsi256_si128(chars);
+    const __m128i hi = _mm256_extracti128_si256(chars, 1);
+    __m256i * out = reinterpret_cast<__m256i *>(dest);
+    if constexpr (sizeof(CharT) == 2)
+    {
+        _mm256_storeu_si256(out, _mm256_cvtepu8_epi16(lo));
+        _mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi16(hi));
+    }
+    else
+    {
+        static_assert(sizeof(CharT) == 4, "char16_t or char32_t output");
+        _mm256_storeu_si256(out, _mm256_cvtepu8_epi32(lo));
+        _mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+        _mm256_storeu_si256(out + 2, _mm256_cvtepu8_epi32(hi));
+        _mm256_storeu_si256(out + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+    }
+}
+
+// encodeHexVecImpl widening while storing: no intermediate byte buffer. len is number of src bytes
+template <HexCase H, typename CharT>
+__attribute__((target("avx2"))) inline void
+encodeHexVecWideImpl(CharT * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    const __m128i * input128 = reinterpret_cast<const __m128i *>(src);
+
+    size_t tailLen = raw_length % 16;
+    size_t vectLen = (raw_length - tailLen) >> 4;
+    for (size_t i = 0; i < vectLen; i++)
+    {
+        __m128i av = _mm_lddqu_si128(&input128[i]);
+        storeWidened(dest + (i << 5), hex<H>(byte2nib(av)));
+    }
+
+    if (tailLen > 0)
+    {
+        if constexpr (sizeof(CharT) == 2)
+            FAST_HEX_STAT(EncodeHexVec16Tail, tailLen);
+        else
+            FAST_HEX_STAT(EncodeHexVec32Tail, tailLen);
+    }
+    encodeHexWideImpl<H>(dest + (vectLen << 5), src + (vectLen << 4), RawLength{tailLen});
+}
 #endif // defined(FAST_HEX_AVX2)
 
 #if defined(FAST_HEX_NEON)
@@ -482,6 +705,8 @@ void encodeHexNeon_impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_H
         len -= 16;
     }
 
+    if (len > 0)
+        FAST_HEX_STAT(EncodeHexNeonTail, len);
     encodeHexImpl<H>(dest + (i * 2), src + i, RawLength{len});
 }
 
@@ -546,15 +771,74 @@ void encodeHexNeon16_impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST
     vst1q_u8(dest + 16, interleaved.val[1]);
 }
 
-#endif // FAST_HEX_NEON
+// Zero-extends 16 ASCII characters to char16_t or char32_t
+template <typename CharT>
+inline void storeWidened(CharT * dest, uint8x16_t chars)
+{
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(chars));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(chars));
+    if constexpr (sizeof(CharT) == 2)
+    {
+        uint16_t * out = reinterpret_cast<uint16_t *>(dest);
+        vst1q_u16(out, lo);
+        vst1q_u16(out + 8, hi);
+    }
+    else
+    {
+        static_assert(sizeof(CharT) == 4, "char16_t or char32_t output");
+        uint32_t * out = reinterpret_cast<uint32_t *>(dest);
+        vst1q_u32(out, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+    }
+}
 
-} // namespace heks_detail
+// encodeHexNeon_impl widening while storing. len is number of src bytes
+template <HexCase H, typename CharT>
+void encodeHexNeonWide_impl(CharT * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength raw_len)
+{
+    auto len = static_cast<size_t>(raw_len);
+    // clang-format off
+    alignas(16) constexpr uint8_t HEX_LUT_LOWER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    alignas(16) constexpr uint8_t HEX_LUT_UPPER[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    // clang-format on
+
+    uint8x16_t lut = vld1q_u8((H == HexCase::Upper) ? HEX_LUT_UPPER : HEX_LUT_LOWER);
+
+    size_t i = 0;
+
+    while (len >= 16)
+    {
+        uint8x16_t invec = vld1q_u8(src + i);
+
+        uint8x16_t hi_chars = neon_tbl_q(lut, vshrq_n_u8(invec, 4));
+        uint8x16_t lo_chars = neon_tbl_q(lut, vandq_u8(invec, vdupq_n_u8(0x0F)));
+
+        uint8x16x2_t interleaved = vzipq_u8(hi_chars, lo_chars);
+
+        storeWidened(dest + (i * 2), interleaved.val[0]);
+        storeWidened(dest + (i * 2) + 16, interleaved.val[1]);
+
+        i += 16;
+        len -= 16;
+    }
+
+    if (len > 0)
+    {
+        if constexpr (sizeof(CharT) == 2)
+            FAST_HEX_STAT(EncodeHexNeon16Tail, len);
+        else
+            FAST_HEX_STAT(EncodeHexNeon32Tail, len);
+    }
+    encodeHexWideImpl<H>(dest + (i * 2), src + i, RawLength{len});
+}
 
+#endif // FAST_HEX_NEON
 
 // len is number of dest bytes
-FAST_HEX_FUNCTION_INLINE void decodeHexLUT(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+inline void decodeHexLUTImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    using namespace heks_detail;
     const auto raw_length = static_cast<size_t>(len);
     for (size_t i = 0; i < raw_length; i++)
     {
@@ -567,9 +851,8 @@ FAST_HEX_FUNCTION_INLINE void decodeHexLUT(uint8_t * FAST_HEX_RESTRICT dest, con
 }
 
 // len is number of dest bytes
-FAST_HEX_FUNCTION_INLINE void decodeHexLUT4(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+inline void decodeHexLUT4Impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    using namespace heks_detail;
     const auto raw_length = static_cast<size_t>(len);
     for (size_t i = 0; i < raw_length; i++)
     {
@@ -583,9 +866,8 @@ FAST_HEX_FUNCTION_INLINE void decodeHexLUT4(uint8_t * FAST_HEX_RESTRICT dest, co
 
 
 // len is number or dest bytes (i.e. half of src length)
-FAST_HEX_FUNCTION_INLINE void decodeHexBMI(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+inline void decodeHexBMIImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    using namespace heks_detail;
     const auto raw_length = static_cast<size_t>(len);
     for (size_t i = 0; i < raw_length; i++)
     {
@@ -597,44 +879,159 @@ FAST_HEX_FUNCTION_INLINE void decodeHexBMI(uint8_t * FAST_HEX_RESTRICT dest, con
     }
 }
 
+// 8 hex characters to their 4 bytes (in the low 32 bits), unhexBitManip on every byte
+constexpr uint64_t unhexSWAR(uint64_t chars)
+{
+    // (x & 0xf) + 9 * (x >> 6): bit 6 is set for letters only
+    const uint64_t letters = (chars >> 6) & 0x0101010101010101;
+    const uint64_t nibbles = (chars & 0x0F0F0F0F0F0F0F0F) + (letters << 3) + letters;
+    // Each 16-bit lane holds the high nibble in its low byte, then the lanes are packed together
+    uint64_t bytes = ((nibbles & 0x00FF00FF00FF00FF) << 4) | ((nibbles >> 8) & 0x00FF00FF00FF00FF);
+    bytes = (bytes | (bytes >> 8)) & 0x0000FFFF0000FFFF;
+    return (bytes | (bytes >> 16)) & 0x00000000FFFFFFFF;
+}
 
-FAST_HEX_FUNCTION_INLINE void encodeHexLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+// len is number of dest bytes
+inline void decodeHexSWARImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    heks_detail::encodeHexImpl<heks_detail::HexCase::Lower>(dest, src, len);
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 8 <= raw_length; i += 8)
+        storeLE64(dest + i, unhexSWAR(loadLE64(src + i * 2)) | (unhexSWAR(loadLE64(src + i * 2 + 8)) << 32));
+    decodeHexBMIImpl(dest + i, src + i * 2, RawLength{raw_length - i});
 }
-FAST_HEX_FUNCTION_INLINE void encodeHexUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+// Portable vector kernels written with the GCC/Clang vector extensions: 16-byte vectors, arithmetic and
+// __builtin_shufflevector only, lowered by the compiler to whatever the target has (SSE, VSX, s390x
+// vector, RVV, LSX, or scalar code). The SWAR kernels finish the tails.
+using u8x16 = uint8_t __attribute__((vector_size(16)));
+
+inline u8x16 loadGeneric(const uint8_t * src)
 {
-    heks_detail::encodeHexImpl<heks_detail::HexCase::Upper>(dest, src, len);
+    u8x16 v;
+    std::memcpy(&v, src, sizeof(v));
+    return v;
+}
+
+inline void storeGeneric(uint8_t * dest, u8x16 v)
+{
+    std::memcpy(dest, &v, sizeof(v));
+}
+
+template <HexCase H>
+inline u8x16 hexGeneric(u8x16 nibbles)
+{
+    constexpr uint8_t letters = (H == HexCase::Lower ? 'a' : 'A') - '0' - 10;
+    // The comparison gives 0 or -1 per lane
+    return nibbles + '0' + (reinterpret_cast<u8x16>(nibbles > 9) & letters);
+}
+
+// len is number of src bytes
+template <HexCase H>
+inline void encodeHexGenericImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 16 <= raw_length; i += 16)
+    {
+        const u8x16 in = loadGeneric(src + i);
+        const u8x16 hi = hexGeneric<H>(in >> 4);
+        const u8x16 lo = hexGeneric<H>(in & 0x0F);
+        // clang-format off
+        storeGeneric(dest + i * 2, __builtin_shufflevector(hi, lo, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+        storeGeneric(dest + i * 2 + 16, __builtin_shufflevector(hi, lo, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+        // clang-format on
+    }
+    if (i < raw_length)
+        FAST_HEX_STAT(EncodeHexGenericTail, raw_length - i);
+    encodeHexSWARImpl<H>(dest + i * 2, src + i, RawLength{raw_length - i});
 }
 
+// len is number of dest bytes
+inline void decodeHexGenericImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 16 <= raw_length; i += 16)
+    {
+        // (c & 0xf) + 9 * (c >> 6), as unhexSWAR
+        const u8x16 a = loadGeneric(src + i * 2);
+        const u8x16 b = loadGeneric(src + i * 2 + 16);
+        const u8x16 na = (a & 0x0F) + ((a >> 6) & 1) * 9;
+        const u8x16 nb = (b & 0x0F) + ((b >> 6) & 1) * 9;
+        // clang-format off
+        const u8x16 hi = __builtin_shufflevector(na, nb, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        const u8x16 lo = __builtin_shufflevector(na, nb, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+        // clang-format on
+        storeGeneric(dest + i, (hi << 4) | lo);
+    }
+    if (i < raw_length)
+        FAST_HEX_STAT(DecodeHexGenericTail, raw_length - i);
+    decodeHexSWARImpl(dest + i, src + i * 2, RawLength{raw_length - i});
+}
+#endif // defined(FAST_HEX_GENERIC_SIMD)
 
 #if defined(FAST_HEX_AVX)
-__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
-encodeHex8LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+// Digit values of 16 hex characters: c - 1 is rebased by a pshufb on its high nibble
+__attribute__((target("avx"))) inline __m128i unhexRebase(__m128i chars)
 {
-    heks_detail::encodeHex8Fast<heks_detail::HexCase::Lower>(dest, src);
+    // Rebase constants for hex digits
+    // clang-format off
+    const __m128i delta_rebase = _mm_setr_epi8(
+        0, 0, -47, -47, -54, 0, -86, 0,
+        0, 0, 0, 0, 0, 0, 0, 0
+    );
+    // clang-format on
+    const __m128i vm1 = _mm_add_epi8(chars, _mm_set1_epi8(-1));
+    const __m128i hash_key = _mm_and_si128(_mm_srli_epi32(vm1, 4), _mm_set1_epi8(0x0F));
+    return _mm_add_epi8(vm1, _mm_shuffle_epi8(delta_rebase, hash_key));
 }
 
-__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
-encodeHex8UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+// 32 hex characters to 16 bytes: the maddubs of decodeHex32Maddubs on one 128-bit lane
+__attribute__((target("avx"))) inline void decodeHex16Maddubs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
 {
-    heks_detail::encodeHex8Fast<heks_detail::HexCase::Upper>(dest, src);
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    const __m128i a = _mm_maddubs_epi16(unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars))), weights);
+    const __m128i b = _mm_maddubs_epi16(unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + 16))), weights);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_packus_epi16(a, b));
 }
-#endif
 
-#if defined(FAST_HEX_AVX2)
+// 16 hex characters to 8 bytes: decode_integral8 without the byte reversal
+__attribute__((target("avx"))) inline void decodeHex8Maddubs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
+{
+    const __m128i pairs = _mm_maddubs_epi16(unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars))), _mm_set1_epi16(0x0110));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), _mm_packus_epi16(pairs, pairs));
+}
+#endif // defined(FAST_HEX_AVX)
 
-// len is number or dest bytes (i.e. half of src length)
-__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
-decodeHexVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+#if defined(FAST_HEX_AVX2)
+// 64 hex characters (two vectors) -> 32 bytes
+__attribute__((target("avx2"))) inline __m256i decodeHex32Vec(__m256i av1, __m256i av2)
 {
-    using namespace heks_detail;
-    auto raw_length = static_cast<size_t>(len);
     const __m256i A_MASK = _mm256_setr_epi8(
         0, -1, 2, -1, 4, -1, 6, -1, 8, -1, 10, -1, 12, -1, 14, -1, 0, -1, 2, -1, 4, -1, 6, -1, 8, -1, 10, -1, 12, -1, 14, -1);
     const __m256i B_MASK = _mm256_setr_epi8(
         1, -1, 3, -1, 5, -1, 7, -1, 9, -1, 11, -1, 13, -1, 15, -1, 1, -1, 3, -1, 5, -1, 7, -1, 9, -1, 11, -1, 13, -1, 15, -1);
 
+    __m256i a1 = _mm256_shuffle_epi8(av1, A_MASK);
+    __m256i b1 = _mm256_shuffle_epi8(av1, B_MASK);
+    __m256i a2 = _mm256_shuffle_epi8(av2, A_MASK);
+    __m256i b2 = _mm256_shuffle_epi8(av2, B_MASK);
+
+    a1 = unhexBitManip(a1);
+    a2 = unhexBitManip(a2);
+    b1 = unhexBitManip(b1);
+    b2 = unhexBitManip(b2);
+
+    return nib2byte(a1, b1, a2, b2);
+}
+
+// len is number or dest bytes (i.e. half of src length)
+__attribute__((target("avx2"))) inline void
+decodeHexVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    auto raw_length = static_cast<size_t>(len);
     const __m256i * val3 = reinterpret_cast<const __m256i *>(src);
     __m256i * dec256 = reinterpret_cast<__m256i *>(dest);
 
@@ -642,82 +1039,492 @@ decodeHexVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT
     {
         __m256i av1 = _mm256_loadu_si256(val3++);
         __m256i av2 = _mm256_loadu_si256(val3++);
-        __m256i a1 = _mm256_shuffle_epi8(av1, A_MASK);
-        __m256i b1 = _mm256_shuffle_epi8(av1, B_MASK);
-        __m256i a2 = _mm256_shuffle_epi8(av2, A_MASK);
-        __m256i b2 = _mm256_shuffle_epi8(av2, B_MASK);
-
-        a1 = unhexBitManip(a1);
-        a2 = unhexBitManip(a2);
-        b1 = unhexBitManip(b1);
-        b2 = unhexBitManip(b2);
-
-        __m256i bytes = nib2byte(a1, b1, a2, b2);
-        _mm256_storeu_si256(dec256++, bytes);
+        _mm256_storeu_si256(dec256++, decodeHex32Vec(av1, av2));
         raw_length -= 32;
     }
 
     src = reinterpret_cast<const uint8_t *>(val3);
     dest = reinterpret_cast<uint8_t *>(dec256);
-    decodeHexBMI(dest, src, RawLength{raw_length});
+    if (raw_length > 0)
+        FAST_HEX_STAT(DecodeHexVecTail, raw_length);
+    decodeHexBMIImpl(dest, src, RawLength{raw_length});
 }
 
-__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
-encodeHexLowerVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
-{
-    heks_detail::encodeHexVecImpl<heks_detail::HexCase::Lower>(dest, src, len);
-}
-__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
-encodeHexUpperVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+// As unhexRebase(__m128i), on 32 hex characters
+__attribute__((target("avx2"))) inline __m256i unhexRebase(__m256i chars)
 {
-    heks_detail::encodeHexVecImpl<heks_detail::HexCase::Upper>(dest, src, len);
+    // clang-format off
+    const __m256i delta_rebase = _mm256_setr_epi8(
+        0, 0, -47, -47, -54, 0, -86, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, -47, -47, -54, 0, -86, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    // clang-format on
+    const __m256i vm1 = _mm256_add_epi8(chars, _mm256_set1_epi8(-1));
+    const __m256i hash_key = _mm256_and_si256(_mm256_srli_epi32(vm1, 4), _mm256_set1_epi8(0x0F));
+    return _mm256_add_epi8(vm1, _mm256_shuffle_epi8(delta_rebase, hash_key));
 }
 
-__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
-encodeHex16LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+// decode_integral8 widened to 64 characters: rebase, then maddubs with 0x0110 makes hi * 16 + lo of every
+// pair in a 16-bit lane. Each vector is loaded as characters 0-15 / 32-47 (and 16-31 / 48-63), so the lanes
+// of the packus output are already in order: no permute4x64 as in nib2byte.
+__attribute__((target("avx2"))) inline void decodeHex32Maddubs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
 {
-    heks_detail::encodeHex16Fast<heks_detail::HexCase::Lower>(dest, src);
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    const __m256i a = _mm256_loadu2_m128i(reinterpret_cast<const __m128i *>(chars + 32), reinterpret_cast<const __m128i *>(chars));
+    const __m256i b = _mm256_loadu2_m128i(reinterpret_cast<const __m128i *>(chars + 48), reinterpret_cast<const __m128i *>(chars + 16));
+    const __m256i pairs_a = _mm256_maddubs_epi16(unhexRebase(a), weights);
+    const __m256i pairs_b = _mm256_maddubs_epi16(unhexRebase(b), weights);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), _mm256_packus_epi16(pairs_a, pairs_b));
 }
 
-__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
-encodeHex16UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+// decodeHex32Maddubs, 64 characters per iteration. len is number of dest bytes.
+__attribute__((target("avx2"))) inline void
+decodeHexVecMaddubsImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    heks_detail::encodeHex16Fast<heks_detail::HexCase::Upper>(dest, src);
+    const auto raw_length = static_cast<size_t>(len);
+    size_t i = 0;
+    for (; i + 32 <= raw_length; i += 32)
+        decodeHex32Maddubs(dest + i, src + i * 2);
+    if (i < raw_length)
+        FAST_HEX_STAT(DecodeHexVecMaddubsTail, raw_length - i);
+    decodeHexBMIImpl(dest + i, src + i * 2, RawLength{raw_length - i});
 }
 #endif // defined(FAST_HEX_AVX2)
 
-#if defined(FAST_HEX_NEON)
-
-FAST_HEX_FUNCTION_INLINE void encodeHexNeonLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+// UTF-16 input. Code units are narrowed to bytes and decoded as above; the result is false if any
+// of them is above 0xFF. len is number of dest bytes (i.e. half the number of code units).
+inline bool decodeHexBMI16Impl(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    heks_detail::encodeHexNeon_impl<heks_detail::HexCase::Lower>(dest, src, len);
+    const auto raw_length = static_cast<size_t>(len);
+    unsigned wide = 0;
+    for (size_t i = 0; i < raw_length; i++)
+    {
+        const char16_t a = *src++;
+        const char16_t b = *src++;
+        wide |= static_cast<unsigned>(a | b);
+        const auto hi = static_cast<uint8_t>(unhexBitManip(static_cast<uint8_t>(a)));
+        const auto lo = static_cast<uint8_t>(unhexBitManip(static_cast<uint8_t>(b)));
+        dest[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return wide <= 0xFF;
 }
 
-FAST_HEX_FUNCTION_INLINE void encodeHexNeonUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+#if defined(FAST_HEX_AVX2)
+__attribute__((target("avx2"))) inline bool
+decodeHexVec16Impl(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
 {
-    heks_detail::encodeHexNeon_impl<heks_detail::HexCase::Upper>(dest, src, len);
+    auto raw_length = static_cast<size_t>(len);
+    const __m256i * units = reinterpret_cast<const __m256i *>(src);
+    __m256i * dec256 = reinterpret_cast<__m256i *>(dest);
+    __m256i wide = _mm256_setzero_si256();
+
+    while (raw_length >= 32)
+    {
+        const __m256i u1 = _mm256_loadu_si256(units++);
+        const __m256i u2 = _mm256_loadu_si256(units++);
+        const __m256i u3 = _mm256_loadu_si256(units++);
+        const __m256i u4 = _mm256_loadu_si256(units++);
+        wide = _mm256_or_si256(wide, _mm256_or_si256(_mm256_or_si256(u1, u2), _mm256_or_si256(u3, u4)));
+
+        // packus works per 128-bit lane (lo1 lo2 hi1 hi2), the permute restores the character order
+        const int _0213 = 0b11'01'10'00;
+        const __m256i av1 = _mm256_permute4x64_epi64(_mm256_packus_epi16(u1, u2), _0213);
+        const __m256i av2 = _mm256_permute4x64_epi64(_mm256_packus_epi16(u3, u4), _0213);
+        _mm256_storeu_si256(dec256++, decodeHex32Vec(av1, av2));
+        raw_length -= 32;
+    }
+
+    const bool narrow = _mm256_testz_si256(wide, _mm256_set1_epi16(static_cast<short>(0xFF00))) != 0;
+    if (raw_length > 0)
+        FAST_HEX_STAT(DecodeHexVec16Tail, raw_length);
+    const bool tail_narrow
+        = decodeHexBMI16Impl(reinterpret_cast<uint8_t *>(dec256), reinterpret_cast<const char16_t *>(units), RawLength{raw_length});
+    return narrow && tail_narrow;
 }
+#endif // defined(FAST_HEX_AVX2)
 
-FAST_HEX_FUNCTION_INLINE void encodeHex8LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+#if defined(FAST_HEX_NEON)
+inline uint8x16_t unhexBitManip(uint8x16_t value)
 {
-    heks_detail::encodeHexNeon8_impl<heks_detail::HexCase::Lower>(dest, src);
+    return vaddq_u8(vandq_u8(value, vdupq_n_u8(0xf)), vmulq_u8(vshrq_n_u8(value, 6), vdupq_n_u8(9)));
 }
-FAST_HEX_FUNCTION_INLINE void encodeHex8UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+
+// 32 hex characters to 16 bytes. vld2q de-interleaves the high and low nibble characters, vsli puts the
+// high digit above the low one.
+inline void decodeHexNeon16_impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
 {
-    heks_detail::encodeHexNeon8_impl<heks_detail::HexCase::Upper>(dest, src);
+    const uint8x16x2_t x = vld2q_u8(chars);
+    vst1q_u8(dest, vsliq_n_u8(unhexBitManip(x.val[1]), unhexBitManip(x.val[0]), 4));
 }
 
-FAST_HEX_FUNCTION_INLINE void encodeHex16LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+// 16 hex characters to 8 bytes, both halves decoded in one vector
+inline void decodeHexNeon8_impl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
 {
-    heks_detail::encodeHexNeon16_impl<heks_detail::HexCase::Lower>(dest, src);
+    const uint8x8x2_t x = vld2_u8(chars);
+    const uint8x16_t digits = unhexBitManip(vcombine_u8(x.val[1], x.val[0]));
+    vst1_u8(dest, vsli_n_u8(vget_low_u8(digits), vget_high_u8(digits), 4));
 }
-FAST_HEX_FUNCTION_INLINE void encodeHex16UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+
+inline bool decodeHexNeon16Impl(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
 {
+    auto raw_length = static_cast<size_t>(len);
+    uint16x8_t wide = vdupq_n_u16(0);
+
+    while (raw_length >= 16)
+    {
+        // De-interleaved loads: val[0] holds the high nibble characters, val[1] the low ones
+        const uint16x8x2_t x = vld2q_u16(reinterpret_cast<const uint16_t *>(src));
+        const uint16x8x2_t y = vld2q_u16(reinterpret_cast<const uint16_t *>(src + 16));
+        wide = vorrq_u16(wide, vorrq_u16(vorrq_u16(x.val[0], x.val[1]), vorrq_u16(y.val[0], y.val[1])));
+
+        const uint8x16_t a = unhexBitManip(vcombine_u8(vqmovn_u16(x.val[0]), vqmovn_u16(y.val[0])));
+        const uint8x16_t b = unhexBitManip(vcombine_u8(vqmovn_u16(x.val[1]), vqmovn_u16(y.val[1])));
+        vst1q_u8(dest, vorrq_u8(vshlq_n_u8(a, 4), b));
+
+        src += 32;
+        dest += 16;
+        raw_length -= 16;
+    }
+
+    // The high bytes of all code units, or-ed together
+    const bool narrow = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(wide, 8)), 0) == 0;
+    if (raw_length > 0)
+        FAST_HEX_STAT(DecodeHexNeon16Tail, raw_length);
+    const bool tail_narrow = decodeHexBMI16Impl(dest, src, RawLength{raw_length});
+    return narrow && tail_narrow;
+}
+#endif // FAST_HEX_NEON
+
+} // namespace heks_detail
+
+
+// len is number of dest bytes
+FAST_HEX_FUNCTION_INLINE void decodeHexLUT(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexLUT, len);
+    heks_detail::decodeHexLUTImpl(dest, src, len);
+}
+
+// len is number of dest bytes
+FAST_HEX_FUNCTION_INLINE void decodeHexLUT4(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexLUT4, len);
+    heks_detail::decodeHexLUT4Impl(dest, src, len);
+}
+
+// len is number or dest bytes (i.e. half of src length)
+FAST_HEX_FUNCTION_INLINE void decodeHexBMI(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexBMI, len);
+    heks_detail::decodeHexBMIImpl(dest, src, len);
+}
+
+// len is number of dest bytes (i.e. half of src length)
+FAST_HEX_FUNCTION_INLINE void decodeHexSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexSWAR, len);
+    heks_detail::decodeHexSWARImpl(dest, src, len);
+}
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+FAST_HEX_FUNCTION_INLINE void decodeHexGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexGeneric, len);
+    heks_detail::decodeHexGenericImpl(dest, src, len);
+}
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
+// UTF-16 input, len is number of dest bytes. False if a code unit is above 0xFF.
+FAST_HEX_FUNCTION_INLINE bool decodeHexBMI16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexBMI16, len);
+    return heks_detail::decodeHexBMI16Impl(dest, src, len);
+}
+
+
+FAST_HEX_FUNCTION_INLINE void encodeHexLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLower, len);
+    heks_detail::encodeHexImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpper, len);
+    heks_detail::encodeHexImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+FAST_HEX_FUNCTION_INLINE void encodeHexLowerSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLowerSWAR, len);
+    heks_detail::encodeHexSWARImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexUpperSWAR(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpperSWAR, len);
+    heks_detail::encodeHexSWARImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+FAST_HEX_FUNCTION_INLINE void encodeHexLowerGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLowerGeneric, len);
+    heks_detail::encodeHexGenericImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexUpperGeneric(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpperGeneric, len);
+    heks_detail::encodeHexGenericImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
+// UTF-16 / UTF-32 output, len is number of src bytes
+FAST_HEX_FUNCTION_INLINE void encodeHexLower16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLower16, len);
+    heks_detail::encodeHexWideImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexUpper16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpper16, len);
+    heks_detail::encodeHexWideImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexLower32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLower32, len);
+    heks_detail::encodeHexWideImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexUpper32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpper32, len);
+    heks_detail::encodeHexWideImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+
+#if defined(FAST_HEX_AVX)
+__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
+encodeHex8LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex8LowerFast, 8);
+    heks_detail::encodeHex8Fast<heks_detail::HexCase::Lower>(dest, src);
+}
+
+__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
+encodeHex8UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex8UpperFast, 8);
+    heks_detail::encodeHex8Fast<heks_detail::HexCase::Upper>(dest, src);
+}
+
+__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
+decodeHex8Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex8Fast, 8);
+    heks_detail::decodeHex8Maddubs(dest, src);
+}
+
+__attribute__((target("avx"))) FAST_HEX_FUNCTION_INLINE void
+decodeHex16Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex16Fast, 16);
+    heks_detail::decodeHex16Maddubs(dest, src);
+}
+#endif
+
+#if defined(FAST_HEX_AVX2)
+
+// len is number or dest bytes (i.e. half of src length)
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+decodeHexVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexVec, len);
+    heks_detail::decodeHexVecImpl(dest, src, len);
+}
+
+// len is number or dest bytes (i.e. half of src length)
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+decodeHexVecMaddubs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexVecMaddubs, len);
+    heks_detail::decodeHexVecMaddubsImpl(dest, src, len);
+}
+
+// UTF-16 input, len is number of dest bytes. False if a code unit is above 0xFF.
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE bool
+decodeHexVec16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexVec16, len);
+    return heks_detail::decodeHexVec16Impl(dest, src, len);
+}
+
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexLowerVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLowerVec, len);
+    heks_detail::encodeHexVecImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexUpperVec(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpperVec, len);
+    heks_detail::encodeHexVecImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+// UTF-16 / UTF-32 output, len is number of src bytes
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexLowerVec16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLowerVec16, len);
+    heks_detail::encodeHexVecWideImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexUpperVec16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpperVec16, len);
+    heks_detail::encodeHexVecWideImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexLowerVec32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexLowerVec32, len);
+    heks_detail::encodeHexVecWideImpl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHexUpperVec32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexUpperVec32, len);
+    heks_detail::encodeHexVecWideImpl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHex16LowerFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex16LowerFast, 16);
+    heks_detail::encodeHex16Fast<heks_detail::HexCase::Lower>(dest, src);
+}
+
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+encodeHex16UpperFast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex16UpperFast, 16);
+    heks_detail::encodeHex16Fast<heks_detail::HexCase::Upper>(dest, src);
+}
+
+__attribute__((target("avx2"))) FAST_HEX_FUNCTION_INLINE void
+decodeHex32Fast(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex32Fast, 32);
+    heks_detail::decodeHex32Maddubs(dest, src);
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+
+// UTF-16 input, len is number of dest bytes. False if a code unit is above 0xFF.
+FAST_HEX_FUNCTION_INLINE bool decodeHexNeon16(uint8_t * FAST_HEX_RESTRICT dest, const char16_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(DecodeHexNeon16, len);
+    return heks_detail::decodeHexNeon16Impl(dest, src, len);
+}
+
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonLower(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonLower, len);
+    heks_detail::encodeHexNeon_impl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonUpper(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonUpper, len);
+    heks_detail::encodeHexNeon_impl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+// UTF-16 / UTF-32 output, len is number of src bytes
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonLower16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonLower16, len);
+    heks_detail::encodeHexNeonWide_impl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonUpper16(char16_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonUpper16, len);
+    heks_detail::encodeHexNeonWide_impl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonLower32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonLower32, len);
+    heks_detail::encodeHexNeonWide_impl<heks_detail::HexCase::Lower>(dest, src, len);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHexNeonUpper32(char32_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, RawLength len)
+{
+    FAST_HEX_STAT(EncodeHexNeonUpper32, len);
+    heks_detail::encodeHexNeonWide_impl<heks_detail::HexCase::Upper>(dest, src, len);
+}
+
+FAST_HEX_FUNCTION_INLINE void encodeHex8LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex8LowerNeon, 8);
+    heks_detail::encodeHexNeon8_impl<heks_detail::HexCase::Lower>(dest, src);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHex8UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex8UpperNeon, 8);
+    heks_detail::encodeHexNeon8_impl<heks_detail::HexCase::Upper>(dest, src);
+}
+
+FAST_HEX_FUNCTION_INLINE void encodeHex16LowerNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex16LowerNeon, 16);
+    heks_detail::encodeHexNeon16_impl<heks_detail::HexCase::Lower>(dest, src);
+}
+FAST_HEX_FUNCTION_INLINE void encodeHex16UpperNeon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(EncodeHex16UpperNeon, 16);
     heks_detail::encodeHexNeon16_impl<heks_detail::HexCase::Upper>(dest, src);
 }
 
+FAST_HEX_FUNCTION_INLINE void decodeHex8Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex8Neon, 8);
+    heks_detail::decodeHexNeon8_impl(dest, src);
+}
+FAST_HEX_FUNCTION_INLINE void decodeHex16Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex16Neon, 16);
+    heks_detail::decodeHexNeon16_impl(dest, src);
+}
+FAST_HEX_FUNCTION_INLINE void decodeHex32Neon(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    FAST_HEX_STAT(DecodeHex32Neon, 32);
+    heks_detail::decodeHexNeon16_impl(dest, src);
+    heks_detail::decodeHexNeon16_impl(dest + 16, src + 32);
+}
+
 #endif
 
+#if defined(FAST_HEX_TUNING)
+namespace heks_detail
+{
+using Kernel = void (*)(uint8_t * FAST_HEX_RESTRICT, const uint8_t * FAST_HEX_RESTRICT, RawLength);
+
+// Raw lengths are bucketed by bit width: bucket b holds [2^(b-1), 2^b), the last bucket everything above
+inline constexpr size_t tune_buckets = 18;
+
+constexpr size_t tune_bucket(size_t raw_length)
+{
+    return std::min<size_t>(static_cast<size_t>(std::bit_width(raw_length)), tune_buckets - 1);
+}
+
+// Kernels used by encode_auto/decode_auto per size bucket, installed by heks::tune() (see fast_hex_tune.hpp)
+struct DispatchTable
+{
+    Kernel encode_lower[tune_buckets];
+    Kernel encode_upper[tune_buckets];
+    Kernel decode[tune_buckets];
+};
+
+inline std::atomic<const DispatchTable *> tuned_dispatch{nullptr};
+} // namespace heks_detail
+#endif // defined(FAST_HEX_TUNING)
+
 struct upper_t
 {
     static constexpr heks_detail::HexCase value = heks_detail::HexCase::Upper;
@@ -733,37 +1540,107 @@ template <class Case>
 inline void encode_auto(uint8_t * FAST_HEX_RESTRICT d, const uint8_t * FAST_HEX_RESTRICT s, RawLength n, Case)
 {
     constexpr auto case_type = Case::value;
+    FAST_HEX_STAT(EncodeAuto, n);
+#if defined(FAST_HEX_TUNING)
+    if (const auto * table = heks_detail::tuned_dispatch.load(std::memory_order_acquire))
+    {
+        const auto bucket = heks_detail::tune_bucket(static_cast<size_t>(n));
+        (case_type == heks_detail::HexCase::Lower ? table->encode_lower : table->encode_upper)[bucket](d, s, n);
+        return;
+    }
+#endif
 #if defined(__x86_64__) || defined(_M_X64)
 #    if defined(FAST_HEX_AVX2)
     heks_detail::encodeHexVecImpl<case_type>(d, s, n);
+#    elif defined(FAST_HEX_GENERIC_SIMD)
+    heks_detail::encodeHexGenericImpl<case_type>(d, s, n);
 #    else
     heks_detail::encodeHexImpl<case_type>(d, s, n);
 #    endif
 #elif defined(FAST_HEX_NEON)
     heks_detail::encodeHexNeon_impl<case_type>(d, s, n);
+#elif defined(FAST_HEX_GENERIC_SIMD)
+    heks_detail::encodeHexGenericImpl<case_type>(d, s, n);
 #else
-    heks_detail::encodeHexImpl<case_type>(d, s, n);
+    heks_detail::encodeHexSWARImpl<case_type>(d, s, n);
 #endif
 }
 
 inline void decode_auto(uint8_t * FAST_HEX_RESTRICT d, const uint8_t * FAST_HEX_RESTRICT s, RawLength n)
 {
+    FAST_HEX_STAT(DecodeAuto, n);
+#if defined(FAST_HEX_TUNING)
+    if (const auto * table = heks_detail::tuned_dispatch.load(std::memory_order_acquire))
+    {
+        table->decode[heks_detail::tune_bucket(static_cast<size_t>(n))](d, s, n);
+        return;
+    }
+#endif
 #if defined(__x86_64__) || defined(_M_X64)
 #    if defined(FAST_HEX_AVX2)
-    decodeHexVec(d, s, n);
+    heks_detail::decodeHexVecMaddubsImpl(d, s, n);
+#    elif defined(FAST_HEX_GENERIC_SIMD)
+    heks_detail::decodeHexGenericImpl(d, s, n);
 #    elif defined(__BMI__)
-    decodeHexBMI(d, s, n);
+    heks_detail::decodeHexBMIImpl(d, s, n);
 #    else
-    decodeHexLUT4(d, s, n);
+    heks_detail::decodeHexLUT4Impl(d, s, n);
 #    endif
 #elif defined(__arm__) || defined(__aarch64__) || defined(_M_ARM) || defined(_M_ARM64)
 #    if defined(FAST_HEX_ARM)
-    decodeHexBMI(d, s, n);
+    heks_detail::decodeHexBMIImpl(d, s, n);
+#    elif defined(FAST_HEX_GENERIC_SIMD)
+    heks_detail::decodeHexGenericImpl(d, s, n);
 #    else
-    decodeHexLUT(d, s, n);
+    heks_detail::decodeHexSWARImpl(d, s, n);
 #    endif
+#elif defined(FAST_HEX_GENERIC_SIMD)
+    heks_detail::decodeHexGenericImpl(d, s, n);
+#else
+    heks_detail::decodeHexSWARImpl(d, s, n);
+#endif
+}
+
+namespace heks_detail
+{
+template <HexCase H, typename CharT>
+inline void encodeHexAutoWide(CharT * FAST_HEX_RESTRICT d, const uint8_t * FAST_HEX_RESTRICT s, RawLength n)
+{
+#if defined(FAST_HEX_AVX2)
+    encodeHexVecWideImpl<H>(d, s, n);
+#elif defined(FAST_HEX_NEON)
+    encodeHexNeonWide_impl<H>(d, s, n);
+#else
+    encodeHexWideImpl<H>(d, s, n);
+#endif
+}
+} // namespace heks_detail
+
+// UTF-16 (char16_t) / UTF-32 (char32_t) output, widened while storing
+template <class Case>
+inline void encode_auto16(char16_t * FAST_HEX_RESTRICT d, const uint8_t * FAST_HEX_RESTRICT s, RawLength n, Case)
+{
+    FAST_HEX_STAT(EncodeAuto16, n);
+    heks_detail::encodeHexAutoWide<Case::value>(d, s, n);
+}
+
+template <class Case>
+inline void encode_auto32(char32_t * FAST_HEX_RESTRICT d, const uint8_t * FAST_HEX_RESTRICT s, RawLength n, Case)
+{
+    FAST_HEX_STAT(EncodeAuto32, n);
+    heks_detail::encodeHexAutoWide<Case::value>(d, s, n);
+}
+
+// UTF-16 input (JavaScript, Java/JNI, Qt, Windows). False if a code unit is above 0xFF.
+inline bool decode_auto16(uint8_t * FAST_HEX_RESTRICT d, const char16_t * FAST_HEX_RESTRICT s, RawLength n)
+{
+    FAST_HEX_STAT(DecodeAuto16, n);
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::decodeHexVec16Impl(d, s, n);
+#elif defined(FAST_HEX_NEON)
+    return heks_detail::decodeHexNeon16Impl(d, s, n);
 #else
-    decodeHexLUT4(d, s, n);
+    return heks_detail::decodeHexBMI16Impl(d, s, n);
 #endif
 }
 
@@ -818,20 +1695,8 @@ T decode_integral_naive(const uint8_t * src)
 // Based on https://github.com/lemire/Code-used-on-Daniel-Lemire-s-blog/blob/master/2023/07/27/src/base16.c
 __attribute__((target("avx"))) inline uint64_t decode_integral8(const uint8_t * src)
 {
-    // Rebase constants for hex digits
-    // clang-format off
-    const __m128i delta_rebase = _mm_setr_epi8(
-        0, 0, -47, -47, -54, 0, -86, 0,
-        0, 0, 0, 0, 0, 0, 0, 0
-    );
-    // clang-format on
-
-    // Load 16 hex characters
-    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
-    // Convert ASCII to 0-15 values
-    __m128i vm1 = _mm_add_epi8(v, _mm_set1_epi8(-1));
-    __m128i hash_key = _mm_and_si128(_mm_srli_epi32(vm1, 4), _mm_set1_epi8(0x0F));
-    v = _mm_add_epi8(vm1, _mm_shuffle_epi8(delta_rebase, hash_key));
+    // Load 16 hex characters and convert them to 0-15 values
+    const __m128i v = heks_detail::unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
 
     // v now has 16 bytes, each with hex digit (0-15) in lower nibble
     const __m128i t3 = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0110));
@@ -940,4 +1805,187 @@ void encode_integral2x8(uint8_t * FAST_HEX_RESTRICT output, const T * FAST_HEX_R
 }
 #endif
 
+namespace heks_detail
+{
+
+// Calls block(offset) at offsets 0, Width, 2 * Width, ... and, when Width does not divide N, once more at
+// N - Width: the last block overlaps the one before it and writes the same output again. Every offset is
+// a constant, so nothing is left of this but the blocks.
+template <size_t N, size_t Width, class Block>
+inline void fixedBlocks(Block && block)
+{
+    static_assert(N >= Width, "at least one whole block");
+    [&]<size_t... I>(std::index_sequence<I...>) { (block(I * Width), ...); }(std::make_index_sequence<N / Width>{});
+    if constexpr (N % Width != 0)
+        block(N - Width);
+}
+
+// Width bytes of src to 2 * Width hex characters
+template <size_t Width, HexCase H>
+inline void encodeHexBlock(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    if constexpr (Width == 16)
+    {
+#if defined(FAST_HEX_AVX2)
+        encodeHex16Fast<H>(dest, src);
+#elif defined(FAST_HEX_NEON)
+        encodeHexNeon16_impl<H>(dest, src);
+#else
+        encodeHexBlock<8, H>(dest, src);
+        encodeHexBlock<8, H>(dest + 16, src + 8);
+#endif
+    }
+    else if constexpr (Width == 8)
+    {
+#if defined(FAST_HEX_AVX)
+        encodeHex8Fast<H>(dest, src);
+#elif defined(FAST_HEX_NEON)
+        encodeHexNeon8_impl<H>(dest, src);
+#else
+        const uint64_t x = loadLE64(src);
+        storeLE64(dest, hexSWAR<H>(x & 0xFFFFFFFF));
+        storeLE64(dest + 8, hexSWAR<H>(x >> 32));
+#endif
+    }
+    else if constexpr (Width == 4)
+    {
+        const uint64_t x = uint64_t{src[0]} | (uint64_t{src[1]} << 8) | (uint64_t{src[2]} << 16) | (uint64_t{src[3]} << 24);
+        storeLE64(dest, hexSWAR<H>(x));
+    }
+    else
+    {
+        static_assert(Width == 1, "16, 8, 4 or 1 byte blocks");
+        const auto & hex_table = (H == HexCase::Lower) ? hex_to_char_lower_sv : hex_to_char_upper_sv;
+        std::memcpy(dest, &hex_table[static_cast<size_t>(src[0]) * 2], 2);
+    }
+}
+
+
+// 2 * Width hex characters of src to Width bytes
+template <size_t Width>
+inline void decodeHexBlock(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    if constexpr (Width == 32)
+    {
+#if defined(FAST_HEX_AVX2)
+        decodeHex32Maddubs(dest, src);
+#else
+        decodeHexBlock<16>(dest, src);
+        decodeHexBlock<16>(dest + 16, src + 32);
+#endif
+    }
+    else if constexpr (Width == 16)
+    {
+#if defined(FAST_HEX_AVX)
+        decodeHex16Maddubs(dest, src);
+#elif defined(FAST_HEX_NEON)
+        decodeHexNeon16_impl(dest, src);
+#else
+        decodeHexBlock<8>(dest, src);
+        decodeHexBlock<8>(dest + 8, src + 16);
+#endif
+    }
+    else if constexpr (Width == 8)
+    {
+#if defined(FAST_HEX_AVX)
+        decodeHex8Maddubs(dest, src);
+#elif defined(FAST_HEX_NEON)
+        decodeHexNeon8_impl(dest, src);
+#else
+        storeLE64(dest, unhexSWAR(loadLE64(src)) | (unhexSWAR(loadLE64(src + 8)) << 32));
+#endif
+    }
+    else if constexpr (Width == 4)
+    {
+        const uint64_t bytes = unhexSWAR(loadLE64(src));
+        for (size_t k = 0; k < 4; ++k)
+            dest[k] = static_cast<uint8_t>(bytes >> (k * 8));
+    }
+    else
+    {
+        static_assert(Width == 1, "32, 16, 8, 4 or 1 byte blocks");
+        dest[0] = static_cast<uint8_t>((unhexBitManip(src[0]) << 4) | unhexBitManip(src[1]));
+    }
+}
+
+// Widest block that fits in N bytes
+template <size_t N, size_t Widest>
+constexpr size_t fixedBlockWidth = N >= Widest ? Widest : N >= 8 ? 8 : N >= 4 ? 4 : 1;
+
+} // namespace heks_detail
+
+// Encodes exactly N bytes of src to 2 * N hex characters, N known at compile time:
+//
+//   heks::encode<20, heks::lower_t>(dest, sha1);
+//
+// The call expands to a fixed sequence of 16, 8 or 4 byte vector (or SWAR) steps, the last one
+// overlapping the one before it when the step does not divide N: no loop, no tail, no branch on the length.
+template <size_t N, class Case>
+inline void encode(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, Case = {})
+{
+    using namespace heks_detail;
+    constexpr auto case_type = Case::value;
+    if constexpr (N > 0)
+    {
+        constexpr size_t width = fixedBlockWidth<N, 16>;
+        fixedBlocks<N, width>([&](size_t i) { encodeHexBlock<width, case_type>(dest + i * 2, src + i); });
+    }
+}
+
+// Decodes 2 * N hex characters of src to exactly N bytes, N known at compile time, in 32, 16, 8 or 4 byte
+// steps as encode<N>. Input must be valid hex, as for decode_auto.
+template <size_t N>
+inline void decode(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src)
+{
+    using namespace heks_detail;
+    if constexpr (N > 0)
+    {
+        constexpr size_t width = N >= 32 ? 32 : fixedBlockWidth<N, 16>;
+        fixedBlocks<N, width>([&](size_t i) { decodeHexBlock<width>(dest + i, src + i * 2); });
+    }
+}
+
+#if defined(FAST_HEX_STATS)
+// Calls, bytes and size histograms per entry point and fallback, summed over all threads since the last
+// stats_reset(). Lock-free; counts of calls running concurrently may or may not be included.
+FAST_HEX_FUNCTION_INLINE StatsSnapshot stats_snapshot()
+{
+    using namespace heks_detail;
+    StatsSnapshot snapshot;
+    stats_collect(snapshot);
+    auto since_reset = [](uint64_t total, const std::atomic<uint64_t> & baseline)
+    {
+        const auto base = baseline.load(std::memory_order_relaxed);
+        return total > base ? total - base : 0;
+    };
+    for (size_t path = 0; path < stats_path_count; ++path)
+    {
+        const auto & baseline = stats_baseline.paths[path];
+        auto & entry = snapshot.paths[path];
+        entry.calls = since_reset(entry.calls, baseline.calls);
+        entry.bytes = since_reset(entry.bytes, baseline.bytes);
+        for (size_t bucket = 0; bucket < stats_size_buckets; ++bucket)
+            entry.sizes[bucket] = since_reset(entry.sizes[bucket], baseline.sizes[bucket]);
+    }
+    return snapshot;
+}
+
+// Counters are owned by their threads, so a reset records the current totals as the new baseline
+FAST_HEX_FUNCTION_INLINE void stats_reset()
+{
+    using namespace heks_detail;
+    StatsSnapshot totals;
+    stats_collect(totals);
+    for (size_t path = 0; path < stats_path_count; ++path)
+    {
+        auto & baseline = stats_baseline.paths[path];
+        const auto & entry = totals.paths[path];
+        baseline.calls.store(entry.calls, std::memory_order_relaxed);
+        baseline.bytes.store(entry.bytes, std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < stats_size_buckets; ++bucket)
+            baseline.sizes[bucket].store(entry.sizes[bucket], std::memory_order_relaxed);
+    }
+}
+#endif // defined(FAST_HEX_STATS)
+
 FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Hex strings of any number of digits, starting at any nibble of the binary side: odd-length BCD and EMV
+// fields, packed 4-bit values, digits of a hash that start halfway into a byte.
+//
+// Nibble 2k of a buffer is the high nibble of byte k, nibble 2k + 1 its low nibble. Only the nibbles at
+// either end that do not fill a byte are handled on their own (hex<H> / unhexBitManip); the whole bytes
+// between them go straight through encode_auto / decode_auto, with no copy into a padded buffer.
+//
+//   uint8_t pan[8];
+//   heks::decode_padded(pan, digits, heks::NibbleLength{15}, heks::NibblePad::Right, 0xF); // 47 61 .. 1F
+//
+// As decode_auto, the decoders do not validate their input.
+
+FAST_HEX_NAMESPACE_OPEN
+
+// Length of hex data in digits (e.g "ABC" is 3 nibbles)
+enum class NibbleLength : size_t;
+
+// Side of the byte that holds the padding nibble of an odd-length value
+enum class NibblePad : uint8_t
+{
+    Left, // "ABC" <-> 0A BC: numbers, BCD
+    Right // "ABC" <-> AB C0 (or CF with a pad of 0xF, as EMV PANs)
+};
+
+// Number of bytes that hold len nibbles
+constexpr size_t padded_size(NibbleLength len)
+{
+    return (static_cast<size_t>(len) + 1) / 2;
+}
+
+// Encodes the len nibbles of src from nibble offset into len characters of dest
+template <class Case = upper_t>
+void encode_nibbles(
+    uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, NibbleLength len, size_t offset = 0, Case = {})
+{
+    constexpr auto case_type = Case::value;
+    size_t n = static_cast<size_t>(len);
+    src += offset / 2;
+    if (offset % 2 != 0 && n != 0)
+    {
+        *dest++ = static_cast<uint8_t>(heks_detail::hex<case_type>(*src++));
+        --n;
+    }
+    const size_t whole = n / 2;
+    if (whole != 0)
+        encode_auto(dest, src, RawLength{whole}, Case{});
+    if (n % 2 != 0)
+        dest[2 * whole] = static_cast<uint8_t>(heks_detail::hex<case_type>(static_cast<uint8_t>(src[whole] >> 4)));
+}
+
+// Decodes the len characters of src into the nibbles of dest from nibble offset. The other nibble of a byte
+// that is only partly written (at either end) keeps its value.
+inline void decode_nibbles(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, NibbleLength len, size_t offset = 0)
+{
+    size_t n = static_cast<size_t>(len);
+    dest += offset / 2;
+    if (offset % 2 != 0 && n != 0)
+    {
+        *dest = static_cast<uint8_t>((*dest & 0xF0) | heks_detail::unhexBitManip(*src++));
+        ++dest;
+        --n;
+    }
+    const size_t whole = n / 2;
+    if (whole != 0)
+        decode_auto(dest, src, RawLength{whole});
+    if (n % 2 != 0)
+        dest[whole] = static_cast<uint8_t>((heks_detail::unhexBitManip(src[n - 1]) << 4) | (dest[whole] & 0x0F));
+}
+
+// Encodes the padded_size(len) bytes of src as len characters, leaving out the padding nibble of an odd len
+template <class Case = upper_t>
+void encode_padded(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, NibbleLength len, NibblePad side, Case = {})
+{
+    encode_nibbles(dest, src, len, side == NibblePad::Left ? static_cast<size_t>(len) % 2 : 0, Case{});
+}
+
+// Decodes len characters into padded_size(len) bytes of dest, the padding nibble of an odd len set to pad.
+// Returns the number of bytes written.
+inline size_t
+decode_padded(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, NibbleLength len, NibblePad side, uint8_t pad = 0)
+{
+    const size_t n = static_cast<size_t>(len);
+    const size_t whole = n / 2;
+    if (n % 2 == 0)
+    {
+        if (whole != 0)
+            decode_auto(dest, src, RawLength{whole});
+        return whole;
+    }
+    if (side == NibblePad::Left)
+    {
+        dest[0] = static_cast<uint8_t>((pad << 4) | heks_detail::unhexBitManip(src[0]));
+        if (whole != 0)
+            decode_auto(dest + 1, src + 1, RawLength{whole});
+    }
+    else
+    {
+        if (whole != 0)
+            decode_auto(dest, src, RawLength{whole});
+        dest[whole] = static_cast<uint8_t>((heks_detail::unhexBitManip(src[n - 1]) << 4) | (pad & 0x0F));
+    }
+    return whole + 1;
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "fast_hex_scan.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// URL percent-encoding (RFC 3986): %XX escapes of the bytes outside a set of characters left as they are.
+//
+// percent_decode finds the '%' of 32 bytes with one compare (AVX2, 16 with NEON) and copies blocks without
+// any as they are. Otherwise the two characters after every position are decoded at once (unhexRebase /
+// unhexBitManip), the escapes put in place of their '%' and their digits squeezed out 8 bytes at a time by
+// a pshufb / vtbl from a table of 256 shuffles. Without SIMD, runs between escapes are found with memchr.
+//
+// percent_encode looks the bytes up in the charset bitmap with two pshufb / vtbl and copies blocks with
+// nothing to escape as they are. Otherwise every byte becomes a 4-byte word, '%' and its digits (hex<H> by
+// pshufb) or the byte itself, stored 3 or 1 bytes apart.
+//
+//   size_t size = heks::percent_decode(query, query, length);             // in place
+//   std::vector<uint8_t> url(3 * length);
+//   url.resize(heks::percent_encode(url.data(), text, length, heks::percent_path));
+//
+// As in the WHATWG URL standard, a '%' that is not followed by two hex digits (either case) is copied as it
+// is, and percent_decode never fails. '+' is left as it is: application/x-www-form-urlencoded callers
+// replace it with a space themselves.
+
+FAST_HEX_NAMESPACE_OPEN
+
+// Bytes that percent_encode leaves as they are, as the two tables of its SIMD lookup: bit k of
+// low[c & 0xF] is set if c = 16 * k + (c & 0xF) below 0x80 is in the set, high[] is the same for 0x80 and above
+struct PercentCharset
+{
+    uint8_t low[16] = {};
+    uint8_t high[16] = {};
+
+    constexpr bool contains(uint8_t c) const
+    {
+        const uint8_t row = c < 0x80 ? low[c & 0xF] : high[c & 0xF];
+        return ((row >> ((c >> 4) & 7)) & 1) != 0;
+    }
+
+    // This set and the characters of chars. '%' must not be one of them, or the result cannot be decoded.
+    constexpr PercentCharset with(std::string_view chars) const
+    {
+        PercentCharset set = *this;
+        for (const char ch : chars)
+        {
+            const auto c = static_cast<uint8_t>(ch);
+            uint8_t & row = c < 0x80 ? set.low[c & 0xF] : set.high[c & 0xF];
+            row = static_cast<uint8_t>(row | (1u << ((c >> 4) & 7)));
+        }
+        return set;
+    }
+};
+
+// RFC 3986 unreserved characters: ALPHA / DIGIT / "-" / "." / "_" / "~"
+inline constexpr PercentCharset percent_unreserved
+    = PercentCharset{}.with("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~");
+// What a path segment or query may hold unescaped: unreserved, sub-delims, ':', '@' and '/'
+inline constexpr PercentCharset percent_path = percent_unreserved.with("!$&'()*+,;=:@/");
+
+namespace heks_detail
+{
+
+// pshufb / vtbl indices moving byte k of an 8-byte group to the front for every bit k of the index
+inline constexpr auto percent_compact_shuffles = []()
+{
+    std::array<uint64_t, 256> shuffles{};
+    for (size_t mask = 0; mask < 256; ++mask)
+    {
+        size_t count = 0;
+        for (size_t k = 0; k < 8; ++k)
+            if (((mask >> k) & 1) != 0)
+                shuffles[mask] |= uint64_t{k} << (8 * count++);
+    }
+    return shuffles;
+}();
+
+// Returns the number of bytes written to dest. dest may be src.
+inline size_t percentDecodeImpl(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    uint8_t * out = dest;
+    size_t i = 0;
+    while (i < len)
+    {
+        const auto * percent = static_cast<const uint8_t *>(std::memchr(src + i, '%', len - i));
+        const size_t run = (percent != nullptr ? static_cast<size_t>(percent - src) : len) - i;
+        std::memmove(out, src + i, run);
+        out += run;
+        i += run;
+        if (i == len)
+            break;
+        if (i + 2 < len && isHexDigit(src[i + 1]) && isHexDigit(src[i + 2]))
+        {
+            *out++ = static_cast<uint8_t>((unhexBitManip(src[i + 1]) << 4) | unhexBitManip(src[i + 2]));
+            i += 3;
+        }
+        else
+            *out++ = src[i++];
+    }
+    return static_cast<size_t>(out - dest);
+}
+
+// dest holds 3 * len bytes, returns the number written
+template <HexCase H>
+inline size_t
+percentEncodeImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t len, const PercentCharset & charset)
+{
+    uint8_t * out = dest;
+    for (size_t i = 0; i < len; ++i)
+    {
+        const uint8_t c = src[i];
+        if (charset.contains(c))
+            *out++ = c;
+        else
+        {
+            out[0] = '%';
+            out[1] = static_cast<uint8_t>(hex<H>(static_cast<uint8_t>(c >> 4)));
+            out[2] = static_cast<uint8_t>(hex<H>(c));
+            out += 3;
+        }
+    }
+    return static_cast<size_t>(out - dest);
+}
+
+#if defined(FAST_HEX_AVX2)
+__attribute__((target("avx2"))) inline size_t percentDecodeVecImpl(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    uint8_t * out = dest;
+    size_t i = 0;
+    // The two characters after the block are loaded with it
+    while (i + 34 <= len)
+    {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i percents = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('%'));
+        if (_mm256_testz_si256(percents, percents) != 0)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chars);
+            out += 32;
+            i += 32;
+            continue;
+        }
+
+        // An escape's digits are never '%', so the escapes of a block do not depend on each other
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 1));
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 2));
+        const __m256i escapes = _mm256_and_si256(percents, _mm256_and_si256(hexDigitBytes(hi), hexDigitBytes(lo)));
+        const __m256i values = _mm256_or_si256(
+            _mm256_and_si256(_mm256_slli_epi16(unhexRebase(hi), 4), _mm256_set1_epi8(static_cast<char>(0xF0))), unhexRebase(lo));
+        const __m256i bytes = _mm256_blendv_epi8(chars, values, escapes);
+
+        // The digits of the last escape may be the first characters of the next block
+        const uint64_t escaped = static_cast<uint32_t>(_mm256_movemask_epi8(escapes));
+        const uint64_t dropped = (escaped << 1) | (escaped << 2);
+        const uint64_t kept = ~dropped;
+        const __m128i halves[2] = {_mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1)};
+        for (size_t g = 0; g < 4; ++g)
+        {
+            const auto group = static_cast<uint8_t>(kept >> (g * 8));
+            const uint64_t shuffle = percent_compact_shuffles[group] + (g % 2 != 0 ? 0x0808080808080808 : 0);
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(halves[g / 2], _mm_cvtsi64_si128(static_cast<long long>(shuffle))));
+            out += std::popcount(group);
+        }
+        i += 32 + static_cast<size_t>(std::popcount(dropped >> 32));
+    }
+    return static_cast<size_t>(out - dest) + percentDecodeImpl(out, src + i, len - i);
+}
+
+// 0xFF in the bytes of chars that are in the set: the row of the low nibble (from high for bytes 0x80 and
+// above), tested against the bit of the high nibble
+__attribute__((target("avx2"))) inline __m256i percentKeptBytes(__m256i chars, __m256i low, __m256i high)
+{
+    const __m256i bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i lo = _mm256_and_si256(chars, nibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(chars, 4), nibble);
+    const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low, lo), _mm256_shuffle_epi8(high, lo), chars);
+    const __m256i bit = _mm256_shuffle_epi8(bits, hi);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+
+template <HexCase H>
+__attribute__((target("avx2"))) size_t
+percentEncodeVecImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t len, const PercentCharset & charset)
+{
+    const auto & digits = (H == HexCase::Lower) ? hex_table_lower_sv : hex_table_upper_sv;
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(digits.data())));
+    const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(charset.low)));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(charset.high)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    uint8_t * out = dest;
+    size_t i = 0;
+    // Every byte of a block with escapes is stored as 4: the 3 * len bytes of dest have room for the last
+    // one while 33 bytes are left
+    for (; i + 33 <= len; i += 32)
+    {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i keep = percentKeptBytes(chars, low, high);
+        const auto kept = static_cast<uint32_t>(_mm256_movemask_epi8(keep));
+        if (kept == 0xFFFFFFFF)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chars);
+            out += 32;
+            continue;
+        }
+
+        // [byte or '%', hi digit, lo digit, 0] words, 4 per 128-bit quarter of each lane
+        const __m256i first = _mm256_blendv_epi8(_mm256_set1_epi8('%'), chars, keep);
+        const __m256i hi_digits = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(chars, 4), nibble));
+        const __m256i lo_digits = _mm256_shuffle_epi8(lut, _mm256_and_si256(chars, nibble));
+        const __m256i pairs_lo = _mm256_unpacklo_epi8(first, hi_digits);
+        const __m256i pairs_hi = _mm256_unpackhi_epi8(first, hi_digits);
+        const __m256i tails_lo = _mm256_unpacklo_epi8(lo_digits, zero);
+        const __m256i tails_hi = _mm256_unpackhi_epi8(lo_digits, zero);
+        const __m256i w0 = _mm256_unpacklo_epi16(pairs_lo, tails_lo);
+        const __m256i w1 = _mm256_unpackhi_epi16(pairs_lo, tails_lo);
+        const __m256i w2 = _mm256_unpacklo_epi16(pairs_hi, tails_hi);
+        const __m256i w3 = _mm256_unpackhi_epi16(pairs_hi, tails_hi);
+
+        alignas(32) uint8_t words[128];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(words), _mm256_permute2x128_si256(w0, w1, 0x20));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(words + 32), _mm256_permute2x128_si256(w2, w3, 0x20));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(words + 64), _mm256_permute2x128_si256(w0, w1, 0x31));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(words + 96), _mm256_permute2x128_si256(w2, w3, 0x31));
+        for (size_t k = 0; k < 32; ++k)
+        {
+            std::memcpy(out, words + k * 4, 4);
+            out += 3 - 2 * ((kept >> k) & 1);
+        }
+    }
+    return static_cast<size_t>(out - dest) + percentEncodeImpl<H>(out, src + i, len - i, charset);
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+inline size_t percentDecodeNeonImpl(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    uint8_t * out = dest;
+    size_t i = 0;
+    while (i + 18 <= len)
+    {
+        const uint8x16_t chars = vld1q_u8(src + i);
+        const uint8x16_t percents = vceqq_u8(chars, vdupq_n_u8('%'));
+        if (byteMask(percents) == 0)
+        {
+            vst1q_u8(out, chars);
+            out += 16;
+            i += 16;
+            continue;
+        }
+
+        const uint8x16_t hi = vld1q_u8(src + i + 1);
+        const uint8x16_t lo = vld1q_u8(src + i + 2);
+        const uint8x16_t escapes = vandq_u8(percents, vandq_u8(hexDigitBytes(hi), hexDigitBytes(lo)));
+        const uint8x16_t values = vsliq_n_u8(unhexBitManip(lo), unhexBitManip(hi), 4);
+        const uint8x16_t bytes = vbslq_u8(escapes, values, chars);
+
+        const uint32_t escaped = byteMask(escapes);
+        const uint32_t dropped = (escaped << 1) | (escaped << 2);
+        const uint32_t kept = ~dropped;
+        const uint8x8_t halves[2] = {vget_low_u8(bytes), vget_high_u8(bytes)};
+        for (size_t g = 0; g < 2; ++g)
+        {
+            const auto group = static_cast<uint8_t>(kept >> (g * 8));
+            vst1_u8(out, vtbl1_u8(halves[g], vcreate_u8(percent_compact_shuffles[group])));
+            out += std::popcount(group);
+        }
+        i += 16 + static_cast<size_t>(std::popcount(dropped >> 16));
+    }
+    return static_cast<size_t>(out - dest) + percentDecodeImpl(out, src + i, len - i);
+}
+
+template <HexCase H>
+size_t
+percentEncodeNeonImpl(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT src, size_t len, const PercentCharset & charset)
+{
+    alignas(16) constexpr uint8_t bits[] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const auto & digits = (H == HexCase::Lower) ? hex_table_lower_sv : hex_table_upper_sv;
+    const uint8x16_t lut = vld1q_u8(reinterpret_cast<const uint8_t *>(digits.data()));
+    const uint8x16_t low = vld1q_u8(charset.low);
+    const uint8x16_t high = vld1q_u8(charset.high);
+    const uint8x16_t bit_table = vld1q_u8(bits);
+
+    uint8_t * out = dest;
+    size_t i = 0;
+    // As percentEncodeVecImpl: room for the 4-byte stores while 17 bytes are left
+    for (; i + 17 <= len; i += 16)
+    {
+        const uint8x16_t chars = vld1q_u8(src + i);
+        const uint8x16_t lo = vandq_u8(chars, vdupq_n_u8(0x0F));
+        const uint8x16_t hi = vshrq_n_u8(chars, 4);
+        const uint8x16_t row = vbslq_u8(vcgeq_u8(chars, vdupq_n_u8(0x80)), neon_tbl_q(high, lo), neon_tbl_q(low, lo));
+        const uint8x16_t keep = vtstq_u8(row, neon_tbl_q(bit_table, hi));
+        const uint32_t kept = byteMask(keep);
+        if (kept == 0xFFFF)
+        {
+            vst1q_u8(out, chars);
+            out += 16;
+            continue;
+        }
+
+        // vst4 interleaves the [byte or '%', hi digit, lo digit, 0] words
+        uint8x16x4_t planes;
+        planes.val[0] = vbslq_u8(keep, chars, vdupq_n_u8('%'));
+        planes.val[1] = neon_tbl_q(lut, hi);
+        planes.val[2] = neon_tbl_q(lut, lo);
+        planes.val[3] = vdupq_n_u8(0);
+        alignas(16) uint8_t words[64];
+        vst4q_u8(words, planes);
+        for (size_t k = 0; k < 16; ++k)
+        {
+            std::memcpy(out, words + k * 4, 4);
+            out += 3 - 2 * ((kept >> k) & 1);
+        }
+    }
+    return static_cast<size_t>(out - dest) + percentEncodeImpl<H>(out, src + i, len - i, charset);
+}
+#endif // FAST_HEX_NEON
+
+} // namespace heks_detail
+
+// Decodes the %XX escapes of the len characters of src into dest, which may be src (decoding in place).
+// Returns the number of bytes written, at most len.
+inline size_t percent_decode(uint8_t * dest, const uint8_t * src, size_t len)
+{
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::percentDecodeVecImpl(dest, src, len);
+#elif defined(FAST_HEX_NEON)
+    return heks_detail::percentDecodeNeonImpl(dest, src, len);
+#else
+    return heks_detail::percentDecodeImpl(dest, src, len);
+#endif
+}
+
+// Escapes the bytes of src that are not in charset as %XX (uppercase digits by default, as RFC 3986
+// recommends). dest must hold 3 * len bytes; returns the number written, the bytes after them are unspecified.
+template <class Case = upper_t>
+size_t percent_encode(
+    uint8_t * FAST_HEX_RESTRICT dest,
+    const uint8_t * FAST_HEX_RESTRICT src,
+    size_t len,
+    const PercentCharset & charset = percent_unreserved,
+    Case = {})
+{
+    constexpr auto case_type = Case::value;
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::percentEncodeVecImpl<case_type>(dest, src, len, charset);
+#elif defined(FAST_HEX_NEON)
+    return heks_detail::percentEncodeNeonImpl<case_type>(dest, src, len, charset);
+#else
+    return heks_detail::percentEncodeImpl<case_type>(dest, src, len, charset);
+#endif
+}
+
+FAST_HEX_NAMESPACE_CLOSE
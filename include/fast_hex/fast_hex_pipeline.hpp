@@ -0,0 +1,583 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#    error "fast_hex_pipeline.hpp requires POSIX"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <semaphore>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#    define FAST_HEX_HAVE_IO_URING 1
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#endif
+
+// Streaming encode/decode between file descriptors (pipes, sockets, files) that overlaps reading
+// chunk N+1, converting chunk N and writing chunk N-1.
+//
+//   heks::Pipeline pipeline;                     // allocates the ring of chunk buffers once
+//   if (auto ec = pipeline.encode(STDIN_FILENO, STDOUT_FILENO, heks::lower))
+//       std::fprintf(stderr, "%s\n", ec.message().c_str());
+//
+// Each chunk is converted by one encode_auto/decode_auto call on the calling thread. I/O goes through
+// io_uring where the kernel supports it (Linux 5.6+, one read and one write in flight), otherwise
+// through a reader and a writer thread. Chunks are read completely before conversion, so the stream is
+// cut at chunk_size boundaries whatever the pipe delivers. Like the other decoders, decode does not
+// validate its input; an odd number of input bytes is reported as std::errc::invalid_argument after
+// the complete pairs were written.
+//
+// After a failed write the read in flight is cancelled (IORING_OP_ASYNC_CANCEL, or a wake-up pipe the
+// reader thread polls alongside the input), so an input that stays open does not keep the call waiting.
+
+FAST_HEX_NAMESPACE_OPEN
+
+enum class PipelineBackend : uint8_t
+{
+    Auto,
+    IoUring,
+    Threads,
+};
+
+struct PipelineOptions
+{
+    // Raw (binary) bytes per chunk
+    size_t chunk_size = size_t{1} << 20;
+    // Chunks in the ring: one read, one converted and one written at a time, plus slack for jitter
+    size_t buffers = 4;
+    PipelineBackend backend = PipelineBackend::Auto;
+};
+
+namespace heks_detail
+{
+
+using PipelineKernel = void (*)(uint8_t *, const uint8_t *, RawLength);
+
+struct PipelineFree
+{
+    void operator()(uint8_t * p) const { ::operator delete[](p, std::align_val_t{4096}); }
+};
+
+// One chunk: the input as read and the converted output
+struct PipelineSlot
+{
+    uint8_t * in = nullptr;
+    uint8_t * out = nullptr;
+    size_t in_len = 0;
+    size_t out_len = 0;
+    size_t out_done = 0;
+    bool last = false;
+};
+
+inline std::error_code pipeline_error(int error)
+{
+    return {error, std::generic_category()};
+}
+
+// Waits until a non-blocking descriptor is ready again
+inline void pipeline_wait(int fd, short events)
+{
+    pollfd p{fd, events, 0};
+    ::poll(&p, 1, -1);
+}
+
+// Reads until size bytes or end of input. With a cancel_fd, each read waits until fd or cancel_fd is
+// readable, and returns ECANCELED once cancel_fd is: a reader blocked on an idle pipe can be stopped.
+inline std::error_code read_full(int fd, uint8_t * data, size_t size, size_t & done, int cancel_fd = -1)
+{
+    done = 0;
+    while (done < size)
+    {
+        if (cancel_fd >= 0 && fd >= 0)
+        {
+            pollfd p[2] = {{fd, POLLIN, 0}, {cancel_fd, POLLIN, 0}};
+            if (::poll(p, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return pipeline_error(errno);
+            }
+            if (p[1].revents != 0)
+                return pipeline_error(ECANCELED);
+        }
+        const ssize_t got = ::read(fd, data + done, size - done);
+        if (got > 0)
+            done += static_cast<size_t>(got);
+        else if (got == 0)
+            break;
+        else if ((errno == EAGAIN || errno == EWOULDBLOCK) && cancel_fd < 0)
+            pipeline_wait(fd, POLLIN);
+        else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+            return pipeline_error(errno);
+    }
+    return {};
+}
+
+inline std::error_code write_full(int fd, const uint8_t * data, size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t done = ::write(fd, data, size);
+        if (done >= 0)
+        {
+            data += done;
+            size -= static_cast<size_t>(done);
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            pipeline_wait(fd, POLLOUT);
+        else if (errno != EINTR)
+            return pipeline_error(errno);
+    }
+    return {};
+}
+
+#if defined(FAST_HEX_HAVE_IO_URING)
+// Minimal io_uring over the raw system calls: queue reads and writes, submit, reap completions
+class IoUring
+{
+public:
+    explicit IoUring(unsigned entries)
+    {
+        io_uring_params params{};
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0)
+            return;
+        // Reads and writes at the current file position (offset -1) need IORING_FEAT_RW_CUR_POS (5.6)
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0 || !map(params))
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    ~IoUring()
+    {
+        if (sqes_ != nullptr)
+            ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+            ::munmap(cq_ring_, cq_size_);
+        if (sq_ring_ != nullptr)
+            ::munmap(sq_ring_, sq_size_);
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    IoUring(const IoUring &) = delete;
+    IoUring & operator=(const IoUring &) = delete;
+
+    bool valid() const { return fd_ >= 0; }
+
+    // Queues a read or write at the current position, submitted by the next enter()
+    void prepare(uint8_t opcode, int fd, const void * data, size_t size, uint64_t tag)
+    {
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & *sq_mask_;
+        io_uring_sqe & sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uintptr_t>(data);
+        sqe.len = static_cast<unsigned>(std::min<size_t>(size, 1u << 30));
+        sqe.off = ~uint64_t{0};
+        sqe.user_data = tag;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++queued_;
+    }
+
+    // Queues the cancellation of the request tagged target, submitted by the next enter()
+    void prepare_cancel(uint64_t target, uint64_t tag)
+    {
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & *sq_mask_;
+        io_uring_sqe & sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.addr = target;
+        sqe.user_data = tag;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++queued_;
+    }
+
+    // Submits the queued requests and waits for at least wait_for completions
+    std::error_code enter(unsigned wait_for)
+    {
+        for (;;)
+        {
+            const long submitted = ::syscall(__NR_io_uring_enter, fd_, queued_, wait_for, wait_for > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (submitted >= 0)
+            {
+                queued_ -= static_cast<unsigned>(submitted);
+                return {};
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                return pipeline_error(errno);
+        }
+    }
+
+    bool queued() const { return queued_ > 0; }
+
+    // Takes the next completion, false when there is none
+    bool pop(uint64_t & tag, int & result)
+    {
+        const unsigned head = *cq_head_;
+        if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+            return false;
+        const io_uring_cqe & cqe = cqes_[head & *cq_mask_];
+        tag = cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    bool map(const io_uring_params & params)
+    {
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        void * sq = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED)
+            return false;
+        sq_ring_ = static_cast<uint8_t *>(sq);
+        if (single)
+            cq_ring_ = sq_ring_;
+        else
+        {
+            void * cq = ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED)
+                return false;
+            cq_ring_ = static_cast<uint8_t *>(cq);
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void * sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+            return false;
+        sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+        sq_tail_ = reinterpret_cast<unsigned *>(sq_ring_ + params.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned *>(sq_ring_ + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq_ring_ + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned *>(cq_ring_ + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq_ring_ + params.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned *>(cq_ring_ + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq_ring_ + params.cq_off.cqes);
+        return true;
+    }
+
+    int fd_ = -1;
+    unsigned queued_ = 0;
+    uint8_t * sq_ring_ = nullptr;
+    uint8_t * cq_ring_ = nullptr;
+    io_uring_sqe * sqes_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    size_t sqes_size_ = 0;
+    unsigned * sq_tail_ = nullptr;
+    unsigned * sq_mask_ = nullptr;
+    unsigned * sq_array_ = nullptr;
+    unsigned * cq_head_ = nullptr;
+    unsigned * cq_tail_ = nullptr;
+    unsigned * cq_mask_ = nullptr;
+    io_uring_cqe * cqes_ = nullptr;
+};
+#endif
+
+} // namespace heks_detail
+
+class Pipeline
+{
+public:
+    explicit Pipeline(const PipelineOptions & options = {})
+        : chunk_(std::max<size_t>(options.chunk_size, 1))
+        , slots_(std::max<size_t>(options.buffers, 3))
+    {
+        // Each slot holds up to 2 chunks on either side (the hex side of encoding or decoding)
+        const size_t slot_bytes = (chunk_ * 4 + 4095) / 4096 * 4096;
+        memory_.reset(static_cast<uint8_t *>(::operator new[](slot_bytes * slots_.size(), std::align_val_t{4096})));
+        for (size_t i = 0; i < slots_.size(); ++i)
+        {
+            slots_[i].in = memory_.get() + i * slot_bytes;
+            slots_[i].out = slots_[i].in + chunk_ * 2;
+        }
+#if defined(FAST_HEX_HAVE_IO_URING)
+        if (options.backend != PipelineBackend::Threads)
+        {
+            ring_ = std::make_unique<heks_detail::IoUring>(4);
+            if (!ring_->valid())
+                ring_.reset();
+        }
+#endif
+    }
+
+    // Backend used by encode/decode: IoUring when requested (or Auto) and supported, else Threads
+    PipelineBackend backend() const
+    {
+#if defined(FAST_HEX_HAVE_IO_URING)
+        if (ring_)
+            return PipelineBackend::IoUring;
+#endif
+        return PipelineBackend::Threads;
+    }
+
+    // Encode everything read from in_fd until end of input to out_fd
+    template <class Case>
+    std::error_code encode(int in_fd, int out_fd, Case)
+    {
+        return run(in_fd, out_fd, 1, 2, [](uint8_t * d, const uint8_t * s, RawLength n) { encode_auto(d, s, n, Case{}); });
+    }
+
+    // Decode the hex digits read from in_fd until end of input to out_fd
+    std::error_code decode(int in_fd, int out_fd)
+    {
+        return run(in_fd, out_fd, 2, 1, [](uint8_t * d, const uint8_t * s, RawLength n) { decode_auto(d, s, n); });
+    }
+
+private:
+    using Slot = heks_detail::PipelineSlot;
+
+    Slot & slot(size_t index) { return slots_[index % slots_.size()]; }
+
+    // in_ratio / out_ratio: bytes per raw byte on each side (1 and 2 for encoding)
+    std::error_code run(int in_fd, int out_fd, size_t in_ratio, size_t out_ratio, heks_detail::PipelineKernel kernel)
+    {
+        for (auto & s : slots_)
+            s.in_len = s.out_len = s.out_done = 0, s.last = false;
+        bool odd = false;
+        auto convert = [&](Slot & s)
+        {
+            const size_t raw = s.in_len / in_ratio;
+            kernel(s.out, s.in, RawLength{raw});
+            s.out_len = raw * out_ratio;
+            s.out_done = 0;
+            odd |= s.in_len % in_ratio != 0;
+        };
+        std::error_code ec;
+#if defined(FAST_HEX_HAVE_IO_URING)
+        if (ring_)
+            ec = run_io_uring(in_fd, out_fd, chunk_ * in_ratio, convert);
+        else
+#endif
+            ec = run_threads(in_fd, out_fd, chunk_ * in_ratio, convert);
+        if (!ec && odd)
+            ec = std::make_error_code(std::errc::invalid_argument);
+        return ec;
+    }
+
+    template <typename Convert>
+    std::error_code run_threads(int in_fd, int out_fd, size_t in_chunk, Convert & convert)
+    {
+        std::counting_semaphore<> free_slots(static_cast<std::ptrdiff_t>(slots_.size()));
+        std::counting_semaphore<> filled(0);
+        std::counting_semaphore<> converted(0);
+        std::atomic<bool> failed{false};
+        std::error_code read_ec;
+        std::error_code write_ec;
+        // Written to after a failed write, so that a reader waiting on input that never ends stops
+        int cancel[2];
+        if (::pipe(cancel) != 0)
+            return heks_detail::pipeline_error(errno);
+
+        std::thread reader(
+            [&]
+            {
+                for (size_t i = 0;; ++i)
+                {
+                    free_slots.acquire();
+                    Slot & s = slot(i);
+                    s.in_len = 0;
+                    s.last = failed.load(std::memory_order_relaxed);
+                    if (!s.last)
+                    {
+                        read_ec = heks_detail::read_full(in_fd, s.in, in_chunk, s.in_len, cancel[0]);
+                        s.last = read_ec || s.in_len < in_chunk;
+                    }
+                    const bool last = s.last;
+                    filled.release();
+                    if (last)
+                        return;
+                }
+            });
+        std::thread writer(
+            [&]
+            {
+                for (size_t i = 0;; ++i)
+                {
+                    converted.acquire();
+                    Slot & s = slot(i);
+                    // After a failed write the remaining chunks are only drained
+                    if (!write_ec)
+                    {
+                        write_ec = heks_detail::write_full(out_fd, s.out, s.out_len);
+                        if (write_ec)
+                        {
+                            failed.store(true, std::memory_order_relaxed);
+                            static_cast<void>(::write(cancel[1], "", 1));
+                        }
+                    }
+                    const bool last = s.last;
+                    free_slots.release();
+                    if (last)
+                        return;
+                }
+            });
+
+        for (size_t i = 0;; ++i)
+        {
+            filled.acquire();
+            Slot & s = slot(i);
+            convert(s);
+            const bool last = s.last;
+            converted.release();
+            if (last)
+                break;
+        }
+        reader.join();
+        writer.join();
+        ::close(cancel[0]);
+        ::close(cancel[1]);
+        // A read cancelled after a failed write reports the write error
+        return write_ec ? write_ec : read_ec;
+    }
+
+#if defined(FAST_HEX_HAVE_IO_URING)
+    // Single threaded: the read of the next chunk and the write of the previous one are in flight
+    // while the current one is converted
+    template <typename Convert>
+    std::error_code run_io_uring(int in_fd, int out_fd, size_t in_chunk, Convert & convert)
+    {
+        enum : uint64_t
+        {
+            read_tag,
+            write_tag,
+            cancel_tag
+        };
+        heks_detail::IoUring & ring = *ring_;
+        const size_t count = slots_.size();
+        size_t read = 0; // chunks read completely
+        size_t converted = 0;
+        size_t written = 0;
+        bool reading = false;
+        bool writing = false;
+        bool cancelling = false;
+        bool input_done = false;
+        std::error_code ec;
+
+        for (;;)
+        {
+            if (!ec && !reading && !input_done && read - written < count)
+            {
+                Slot & s = slot(read);
+                ring.prepare(IORING_OP_READ, in_fd, s.in + s.in_len, in_chunk - s.in_len, read_tag);
+                reading = true;
+            }
+            // Nothing to write for an empty last chunk
+            while (!writing && written < converted && slot(written).out_len == 0)
+            {
+                Slot & s = slot(written++);
+                s = Slot{s.in, s.out};
+            }
+            if (!ec && !writing && written < converted)
+            {
+                const Slot & s = slot(written);
+                ring.prepare(IORING_OP_WRITE, out_fd, s.out + s.out_done, s.out_len - s.out_done, write_tag);
+                writing = true;
+            }
+
+            // After an error, a read that may never complete (a pipe kept open) is cancelled, and its
+            // completion and the cancellation's are reaped so that none is left for the next run
+            if (ec && reading && !cancelling)
+            {
+                ring.prepare_cancel(read_tag, cancel_tag);
+                cancelling = true;
+            }
+            if (ec ? !reading && !writing && !cancelling : input_done && written == read)
+                break;
+            // Start the queued I/O and convert while it runs, or wait for it. enter() only fails on
+            // a broken ring; I/O errors arrive as completions.
+            if (!ec && converted < read)
+            {
+                if (ring.queued())
+                    if (auto enter_ec = ring.enter(0))
+                        return enter_ec;
+                convert(slot(converted++));
+            }
+            else if (auto enter_ec = ring.enter(1))
+                return enter_ec;
+
+            uint64_t tag = 0;
+            int result = 0;
+            while (ring.pop(tag, result))
+            {
+                const bool retry = result == -EINTR || result == -EAGAIN;
+                if (tag == cancel_tag)
+                    cancelling = false;
+                else if (tag == read_tag)
+                {
+                    reading = false;
+                    Slot & s = slot(read);
+                    if (retry)
+                        continue;
+                    if (result < 0)
+                    {
+                        if (!ec)
+                            ec = heks_detail::pipeline_error(-result);
+                    }
+                    else
+                        s.in_len += static_cast<size_t>(result);
+                    if (result <= 0 || s.in_len == in_chunk)
+                    {
+                        s.last = result <= 0;
+                        input_done = s.last;
+                        ++read;
+                    }
+                }
+                else
+                {
+                    writing = false;
+                    Slot & s = slot(written);
+                    if (retry)
+                        continue;
+                    if (result < 0)
+                        ec = heks_detail::pipeline_error(-result);
+                    else if ((s.out_done += static_cast<size_t>(result)) == s.out_len)
+                    {
+                        s = Slot{s.in, s.out};
+                        ++written;
+                    }
+                }
+            }
+        }
+        return ec;
+    }
+
+    std::unique_ptr<heks_detail::IoUring> ring_;
+#endif
+
+    size_t chunk_;
+    std::vector<Slot> slots_;
+    std::unique_ptr<uint8_t[], heks_detail::PipelineFree> memory_;
+};
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,664 @@
+#pragma once
+
+#include "fast_hex_scan.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Intel HEX and Motorola S-record (SREC) firmware images: lines of ':' / 'S' records, each a byte count,
+// an address, the record type and up to 255 bytes in hex, ending with an 8-bit checksum.
+//
+// RecordEncoder turns bytes at an address into data records of record_size bytes. Full 16-byte records
+// go through encodeHex16Fast (encodeHexBlock<16>), others through encode_auto, and the checksum is a
+// horizontal sum of the data (psadbw / vpaddl). RecordDecoder takes the text in chunks of any size and
+// carries at most one incomplete record between calls. It checks every record (digits, length, line end,
+// checksum), decodes the data with decodeHexBlock<16> / decode_auto and passes it to a sink in runs of
+// contiguous addresses, collected in a buffer of buffer_size bytes: memory does not grow with the image.
+//
+//   heks::RecordEncoder encoder(heks::RecordFormat::IntelHex);
+//   std::vector<uint8_t> text(encoder.max_encoded_size(chunk));
+//   write(text.data(), encoder.encode(text.data(), data, chunk, 0x08000000));   // then encode(text, data, n)
+//   write(text.data(), encoder.finish(text.data()));                            // for the following bytes
+//
+//   heks::RecordDecoder decoder(heks::RecordFormat::IntelHex);
+//   auto sink = [&](uint32_t address, const uint8_t * data, size_t size) { ... };
+//   if (auto ec = decoder.decode(chunk, size, sink))  // for every chunk, then
+//       std::fprintf(stderr, "line %zu: %s\n", decoder.line(), ec.message().c_str());
+//   auto ec = decoder.finish(sink);
+//
+// Intel HEX: data (00), end of file (01), extended segment address (02), start segment address (03),
+// extended linear address (04) and start linear address (05) records. The encoder writes an 04 record
+// whenever the upper 16 bits of the address change and splits records at 64 KiB boundaries.
+// S-records: S0 header, S1/S2/S3 data with 2, 3 or 4 address bytes, S5/S6 count and S7/S8/S9 termination.
+// The encoder writes the narrowest data records that hold their addresses, at least srec_address_bytes
+// wide, and the termination record matching the widest. Both decoders take upper and lower case digits
+// and "\n" or "\r\n" line ends, and ignore anything after the end of file / termination record. Malformed
+// records are reported as std::errc::invalid_argument.
+
+FAST_HEX_NAMESPACE_OPEN
+
+enum class RecordFormat : uint8_t
+{
+    IntelHex,
+    SRecord,
+};
+
+struct RecordOptions
+{
+    // Data bytes per record, 1 to 255 (at most 250 in S3 records); 16 as written by objcopy
+    size_t record_size = 16;
+    // "\r\n" line ends instead of "\n"
+    bool crlf = false;
+    // S-records: address bytes of the data records, 2 (S1), 3 (S2) or 4 (S3) at least
+    size_t srec_address_bytes = 2;
+    // S-records: contents of an S0 header record written first if not empty, at most 252 bytes
+    std::string_view srec_header = {};
+};
+
+namespace heks_detail
+{
+
+// Longest record line: ':' and 2 * (4 + 255 + 1) digits, or 'S', the type and 2 * (1 + 255) digits, and "\r\n"
+inline constexpr size_t record_line_max = 1 + 2 * 260 + 2;
+
+// Longest line of a record with len data bytes in either format
+constexpr size_t recordLine(size_t len)
+{
+    return 2 * len + 16;
+}
+
+// Two hex digits to their byte
+constexpr uint8_t hexByte(const uint8_t * digits)
+{
+    return static_cast<uint8_t>((unhexBitManip(digits[0]) << 4) | unhexBitManip(digits[1]));
+}
+
+inline uint32_t byteSumScalar(const uint8_t * data, size_t len)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < len; ++i)
+        sum += data[i];
+    return sum;
+}
+
+inline bool allHexDigitsSWAR(const uint8_t * text, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        if (hexDigitMaskSWAR(loadLE64(text + i)) != 0xFF)
+            return false;
+    for (; i < len; ++i)
+        if (!isHexDigit(text[i]))
+            return false;
+    return true;
+}
+
+#if defined(FAST_HEX_AVX2)
+// psadbw against zero adds up every 8 bytes into a 64-bit lane
+__attribute__((target("avx2"))) inline uint32_t byteSumVec(const uint8_t * data, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), zero));
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    if (i + 16 <= len)
+    {
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), _mm_setzero_si128()));
+        i += 16;
+    }
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(sum)) + byteSumScalar(data + i, len - i);
+}
+
+// Whole blocks of 32, then the last 32 bytes again
+__attribute__((target("avx2"))) inline bool allHexDigitsVec(const uint8_t * text, size_t len)
+{
+    if (len < 32)
+        return allHexDigitsSWAR(text, len);
+    __m256i all = _mm256_set1_epi8(-1);
+    for (size_t i = 0; i + 32 <= len; i += 32)
+        all = _mm256_and_si256(all, hexDigitBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i))));
+    all = _mm256_and_si256(all, hexDigitBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + len - 32))));
+    return _mm256_movemask_epi8(all) == -1;
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+// Pairwise widening adds: 16 bytes to 8 halfwords, accumulated into 4 words
+inline uint32_t byteSumNeon(const uint8_t * data, size_t len)
+{
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(data + i)));
+    const uint64x2_t pairs = vpaddlq_u32(acc);
+    return static_cast<uint32_t>(vgetq_lane_u64(pairs, 0) + vgetq_lane_u64(pairs, 1)) + byteSumScalar(data + i, len - i);
+}
+
+inline bool allHexDigitsNeon(const uint8_t * text, size_t len)
+{
+    if (len < 16)
+        return allHexDigitsSWAR(text, len);
+    uint8x16_t all = vdupq_n_u8(0xFF);
+    for (size_t i = 0; i + 16 <= len; i += 16)
+        all = vandq_u8(all, hexDigitBytes(vld1q_u8(text + i)));
+    all = vandq_u8(all, hexDigitBytes(vld1q_u8(text + len - 16)));
+    return byteMask(all) == 0xFFFF;
+}
+#endif // FAST_HEX_NEON
+
+// Sum of the len bytes of data (the checksums only need its low byte)
+inline uint32_t byteSum(const uint8_t * data, size_t len)
+{
+#if defined(FAST_HEX_AVX2)
+    return byteSumVec(data, len);
+#elif defined(FAST_HEX_NEON)
+    return byteSumNeon(data, len);
+#else
+    return byteSumScalar(data, len);
+#endif
+}
+
+inline bool allHexDigits(const uint8_t * text, size_t len)
+{
+#if defined(FAST_HEX_AVX2)
+    return allHexDigitsVec(text, len);
+#elif defined(FAST_HEX_NEON)
+    return allHexDigitsNeon(text, len);
+#else
+    return allHexDigitsSWAR(text, len);
+#endif
+}
+
+inline void encodeRecordData(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    if (len == 16)
+        encodeHexBlock<16, HexCase::Upper>(dest, src);
+    else
+        encode_auto(dest, src, RawLength{len}, upper);
+}
+
+inline void decodeRecordData(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    if (len == 16)
+        decodeHexBlock<16>(dest, src);
+    else if (len == 32)
+        decodeHexBlock<32>(dest, src);
+    else
+        decode_auto(dest, src, RawLength{len});
+}
+
+#if defined(FAST_HEX_AVX)
+// decodeHex16Maddubs, with the sum of the bytes taken from the register rather than loaded back from dest
+__attribute__((target("avx"))) inline uint32_t decodeHex16Sum(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT chars)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    const __m128i a = _mm_maddubs_epi16(unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars))), weights);
+    const __m128i b = _mm_maddubs_epi16(unhexRebase(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + 16))), weights);
+    const __m128i bytes = _mm_packus_epi16(a, b);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), bytes);
+    const __m128i sums = _mm_sad_epu8(bytes, _mm_setzero_si128());
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+}
+#endif // defined(FAST_HEX_AVX)
+
+// Decodes the len bytes of a data field and returns their sum
+inline uint32_t decodeRecordSum(uint8_t * dest, const uint8_t * src, size_t len)
+{
+#if defined(FAST_HEX_AVX)
+    if (len == 16)
+        return decodeHex16Sum(dest, src);
+#endif
+    decodeRecordData(dest, src, len);
+    return byteSum(dest, len);
+}
+
+} // namespace heks_detail
+
+class RecordEncoder
+{
+public:
+    explicit RecordEncoder(RecordFormat format, const RecordOptions & options = {})
+        : format_(format)
+        , record_size_(std::clamp<size_t>(options.record_size, 1, 255))
+        , crlf_(options.crlf)
+        , address_bytes_(std::clamp<size_t>(options.srec_address_bytes, 2, 4))
+        , header_(options.srec_header.substr(0, 252))
+    {
+        reset();
+    }
+
+    // Most bytes written by encode() for len bytes, and by finish()
+    size_t max_encoded_size(size_t len) const
+    {
+        const size_t per_record = std::min<size_t>(record_size_, 250);
+        // Records split at 64 KiB boundaries and extended address records, then the header, start and end records
+        const size_t records = len / per_record + 2 * (len >> 16) + 4;
+        return records * heks_detail::recordLine(per_record) + 3 * heks_detail::record_line_max;
+    }
+
+    // Records for len bytes of src at address; returns the bytes written to dest
+    size_t encode(uint8_t * dest, const uint8_t * src, size_t len, uint32_t address)
+    {
+        uint8_t * out = writeHeader(dest);
+        while (len > 0)
+        {
+            size_t n = std::min(len, record_size_);
+            if (format_ == RecordFormat::IntelHex)
+            {
+                if ((address >> 16) != upper_)
+                {
+                    upper_ = address >> 16;
+                    const uint8_t base[2] = {static_cast<uint8_t>(upper_ >> 8), static_cast<uint8_t>(upper_)};
+                    out = writeIntelHex(out, 0, 0x04, base, 2);
+                }
+                n = std::min<size_t>(n, 0x10000 - (address & 0xFFFF));
+                out = writeIntelHex(out, address & 0xFFFF, 0x00, src, n);
+            }
+            else
+            {
+                const size_t bytes = std::max(address_bytes_, addressBytes(uint64_t{address} + n - 1));
+                // The count byte covers the address, the data and the checksum
+                n = std::min(n, 254 - bytes);
+                widest_ = std::max(widest_, bytes);
+                out = writeSRecord(out, static_cast<uint8_t>('0' + bytes - 1), address, bytes, src, n);
+            }
+            src += n;
+            len -= n;
+            address += static_cast<uint32_t>(n);
+        }
+        next_ = address;
+        return static_cast<size_t>(out - dest);
+    }
+
+    // Records for the bytes following the last ones encoded (from address 0 at first)
+    size_t encode(uint8_t * dest, const uint8_t * src, size_t len) { return encode(dest, src, len, next_); }
+
+    // Ends the image: with Intel HEX a start linear address record if start is given and the end of file
+    // record, with S-records the termination record holding start (or 0). The encoder can then start another.
+    size_t finish(uint8_t * dest, std::optional<uint32_t> start = std::nullopt)
+    {
+        uint8_t * out = writeHeader(dest);
+        if (format_ == RecordFormat::IntelHex)
+        {
+            if (start)
+            {
+                const uint32_t entry_point = *start;
+                const uint8_t entry[4] = {static_cast<uint8_t>(entry_point >> 24), static_cast<uint8_t>(entry_point >> 16),
+                                          static_cast<uint8_t>(entry_point >> 8), static_cast<uint8_t>(entry_point)};
+                out = writeIntelHex(out, 0, 0x05, entry, 4);
+            }
+            out = writeIntelHex(out, 0, 0x01, nullptr, 0);
+        }
+        else
+        {
+            // S7, S8 or S9 for 4, 3 or 2 address bytes
+            const size_t bytes = std::max(widest_, addressBytes(start.value_or(0)));
+            out = writeSRecord(out, static_cast<uint8_t>('0' + 11 - bytes), start.value_or(0), bytes, nullptr, 0);
+        }
+        reset();
+        return static_cast<size_t>(out - dest);
+    }
+
+    uint32_t next_address() const { return next_; }
+
+private:
+    static size_t addressBytes(uint64_t address) { return address > 0xFFFFFF ? 4 : address > 0xFFFF ? 3 : 2; }
+
+    void reset()
+    {
+        next_ = 0;
+        upper_ = 0;
+        widest_ = address_bytes_;
+        header_pending_ = format_ == RecordFormat::SRecord && !header_.empty();
+    }
+
+    uint8_t * writeHeader(uint8_t * out)
+    {
+        if (!header_pending_)
+            return out;
+        header_pending_ = false;
+        return writeSRecord(out, '0', 0, 2, reinterpret_cast<const uint8_t *>(header_.data()), header_.size());
+    }
+
+    // The digits of head and of len bytes of data, the checksum (the low byte of the sum of all of them, one's
+    // complement for S-records, two's complement for Intel HEX) and the line end
+    uint8_t * writeRecord(uint8_t * out, const uint8_t * head, size_t head_len, const uint8_t * data, size_t len)
+    {
+        uint32_t sum = heks_detail::byteSum(data, len);
+        for (size_t k = 0; k < head_len; ++k)
+        {
+            sum += head[k];
+            heks_detail::encodeHexBlock<1, heks_detail::HexCase::Upper>(out + k * 2, head + k);
+        }
+        out += head_len * 2;
+        heks_detail::encodeRecordData(out, data, len);
+        out += len * 2;
+        const auto checksum = static_cast<uint8_t>(~sum + (format_ == RecordFormat::IntelHex ? 1 : 0));
+        heks_detail::encodeHexBlock<1, heks_detail::HexCase::Upper>(out, &checksum);
+        out += 2;
+        if (crlf_)
+            *out++ = '\r';
+        *out++ = '\n';
+        return out;
+    }
+
+    uint8_t * writeIntelHex(uint8_t * out, uint32_t offset, uint8_t type, const uint8_t * data, size_t len)
+    {
+        *out++ = ':';
+        const uint8_t head[4] = {static_cast<uint8_t>(len), static_cast<uint8_t>(offset >> 8), static_cast<uint8_t>(offset), type};
+        return writeRecord(out, head, 4, data, len);
+    }
+
+    uint8_t * writeSRecord(uint8_t * out, uint8_t type, uint32_t address, size_t address_bytes, const uint8_t * data, size_t len)
+    {
+        *out++ = 'S';
+        *out++ = type;
+        uint8_t head[5] = {static_cast<uint8_t>(address_bytes + len + 1)};
+        for (size_t k = 0; k < address_bytes; ++k)
+            head[1 + k] = static_cast<uint8_t>(address >> (8 * (address_bytes - 1 - k)));
+        return writeRecord(out, head, address_bytes + 1, data, len);
+    }
+
+    RecordFormat format_;
+    size_t record_size_;
+    bool crlf_;
+    size_t address_bytes_;
+    std::string header_;
+    bool header_pending_ = false;
+    uint32_t next_ = 0;
+    uint32_t upper_ = 0;
+    size_t widest_ = 2;
+};
+
+class RecordDecoder
+{
+public:
+    // The sink is called with up to buffer_size bytes at a time
+    explicit RecordDecoder(RecordFormat format, size_t buffer_size = size_t{64} << 10)
+        : format_(format)
+        , capacity_(std::max<size_t>(buffer_size, 255))
+        , buffer_(new uint8_t[capacity_])
+    {
+    }
+
+    // Checks and decodes the records of the next len bytes of text. sink(uint32_t address, const uint8_t * data,
+    // size_t size) receives their data in order, in runs of contiguous addresses; the last run waits for finish().
+    template <class Sink>
+    std::error_code decode(const uint8_t * text, size_t len, Sink && sink)
+    {
+        if (error_ || ended_ || len == 0)
+            return error_;
+        if (carry_size_ > 0)
+        {
+            // Complete the record started in the last chunk
+            const size_t old = carry_size_;
+            const size_t take = std::min(len, sizeof(carry_) - old);
+            std::memcpy(carry_ + old, text, take);
+            carry_size_ += take;
+            const auto used = static_cast<size_t>(parse(carry_, carry_ + carry_size_, false, sink) - carry_);
+            if (error_ || ended_)
+                return error_;
+            // Still incomplete: the longest record and its line end fit in carry_, so text was used up
+            if (used < old)
+                return {};
+            text += used - old;
+            len -= used - old;
+            carry_size_ = 0;
+        }
+        const uint8_t * stop = parse(text, text + len, false, sink);
+        if (error_ || ended_)
+            return error_;
+        carry_size_ = static_cast<size_t>(text + len - stop);
+        std::memcpy(carry_, stop, carry_size_);
+        return {};
+    }
+
+    // Decodes a last record without a line end and passes the data still buffered to the sink, even after an error
+    template <class Sink>
+    std::error_code finish(Sink && sink)
+    {
+        if (!error_ && !ended_ && carry_size_ > 0 && parse(carry_, carry_ + carry_size_, true, sink) != carry_ + carry_size_ && !ended_)
+            fail();
+        carry_size_ = 0;
+        flush(sink);
+        return error_;
+    }
+
+    // Whether the end of file (Intel HEX) or a termination record (S7/S8/S9) was decoded
+    bool ended() const { return ended_; }
+    // From a start segment / linear address or termination record
+    std::optional<uint32_t> start_address() const { return start_; }
+    // Line of the current record, from 1: the failing one after an error
+    size_t line() const { return line_; }
+
+private:
+    // Record by record up to the first one not followed by a line end (or the end of input if final); returns
+    // where it stopped, the failing record if error_ is set
+    template <class Sink>
+    const uint8_t * parse(const uint8_t * p, const uint8_t * end, bool final, Sink & sink)
+    {
+        const bool intel = format_ == RecordFormat::IntelHex;
+        // Characters before the digits of the count
+        const size_t prefix = intel ? 1 : 2;
+        while (p != end && !ended_)
+        {
+            if (*p == '\n' || *p == '\r')
+            {
+                line_ += *p++ == '\n' ? 1u : 0u;
+                continue;
+            }
+            const auto available = static_cast<size_t>(end - p);
+            if (*p != (intel ? ':' : 'S'))
+                return fail(p);
+            if (available < prefix + 2)
+                return p;
+            // Records mostly have the count of the one before: comparing its digits is a branch the CPU can
+            // predict and run ahead to the next record, where decoding them would have to finish first
+            uint16_t count_digits = 0;
+            std::memcpy(&count_digits, p + prefix, 2);
+            if (count_digits != count_digits_)
+            {
+                if (!heks_detail::isHexDigit(p[prefix]) || !heks_detail::isHexDigit(p[prefix + 1]))
+                    return fail(p);
+                count_digits_ = count_digits;
+                count_ = heks_detail::hexByte(p + prefix);
+            }
+            const size_t count = count_;
+            const size_t size = intel ? 11 + 2 * count : 4 + 2 * count;
+            if (available < size || (available == size && !final))
+                return p;
+            if (available > size && p[size] != '\n' && p[size] != '\r')
+                return fail(p);
+            if (!(intel ? intelHexRecord(p, count, sink) : sRecord(p, count, sink)))
+                return fail(p);
+            p += size;
+        }
+        return p;
+    }
+
+    // ':', count, 16-bit address, type, count bytes of data, checksum
+    template <class Sink>
+    bool intelHexRecord(const uint8_t * p, size_t count, Sink & sink)
+    {
+        if (!heks_detail::allHexDigits(p + 1, 10 + 2 * count))
+            return false;
+        const auto head = static_cast<uint32_t>(heks_detail::unhexSWAR(heks_detail::loadLE64(p + 1)));
+        // Count, address high and low byte, type
+        const uint32_t offset = (head & 0xFF00) | ((head >> 16) & 0xFF);
+        const uint32_t type = head >> 24;
+        const uint8_t * digits = p + 9;
+        uint32_t sum = (head & 0xFF) + ((head >> 8) & 0xFF) + ((head >> 16) & 0xFF) + type + heks_detail::hexByte(digits + 2 * count);
+        if (type == 0x00)
+        {
+            const uint32_t address = base_ + offset;
+            uint8_t * data = reserve(address, count, sink);
+            if (((sum + heks_detail::decodeRecordSum(data, digits, count)) & 0xFF) != 0)
+                return false;
+            fill_ += count;
+            return true;
+        }
+        // End of file: no data; segment or linear base address: 2 bytes; start address: 4 bytes
+        constexpr uint8_t sizes[6] = {0, 0, 2, 4, 2, 4};
+        if (type > 0x05 || count != sizes[type])
+            return false;
+        uint8_t field[4] = {};
+        for (size_t k = 0; k < count; ++k)
+        {
+            field[k] = heks_detail::hexByte(digits + 2 * k);
+            sum += field[k];
+        }
+        if ((sum & 0xFF) != 0)
+            return false;
+        const uint32_t high = (uint32_t{field[0]} << 8) | field[1];
+        const uint32_t low = (uint32_t{field[2]} << 8) | field[3];
+        if (type == 0x01)
+            ended_ = true;
+        else if (type == 0x02)
+            base_ = high << 4;
+        else if (type == 0x03)
+            start_ = (high << 4) + low;
+        else if (type == 0x04)
+            base_ = high << 16;
+        else
+            start_ = (high << 16) | low;
+        return true;
+    }
+
+    // 'S', type, count, 2 to 4 address bytes, data, checksum; count covers the address, data and checksum
+    template <class Sink>
+    bool sRecord(const uint8_t * p, size_t count, Sink & sink)
+    {
+        constexpr uint8_t address_sizes[10] = {2, 2, 3, 4, 0, 2, 3, 4, 3, 2};
+        const auto type = static_cast<size_t>(p[1] - '0');
+        if (type > 9 || address_sizes[type] == 0 || count < address_sizes[type] + 1u || !heks_detail::allHexDigits(p + 2, 2 + 2 * count))
+            return false;
+        const size_t address_bytes = address_sizes[type];
+        uint32_t address = 0;
+        uint32_t sum = static_cast<uint32_t>(count) + heks_detail::hexByte(p + 2 + 2 * count);
+        for (size_t k = 0; k < address_bytes; ++k)
+        {
+            const uint8_t byte = heks_detail::hexByte(p + 4 + 2 * k);
+            address = (address << 8) | byte;
+            sum += byte;
+        }
+        const uint8_t * digits = p + 4 + 2 * address_bytes;
+        const size_t len = count - address_bytes - 1;
+        if (type >= 1 && type <= 3)
+        {
+            uint8_t * data = reserve(address, len, sink);
+            if (((sum + heks_detail::decodeRecordSum(data, digits, len)) & 0xFF) != 0xFF)
+                return false;
+            fill_ += len;
+            return true;
+        }
+        // Header and count records only have their checksum checked
+        uint8_t field[255];
+        if (((sum + heks_detail::decodeRecordSum(field, digits, len)) & 0xFF) != 0xFF)
+            return false;
+        if (type >= 7)
+        {
+            start_ = address;
+            ended_ = true;
+        }
+        return true;
+    }
+
+    // Room for len bytes at address at the end of the buffer, passed to the sink first if they do not continue it
+    template <class Sink>
+    uint8_t * reserve(uint32_t address, size_t len, Sink & sink)
+    {
+        if (fill_ > 0 && (uint64_t{run_} + fill_ != address || fill_ + len > capacity_))
+            flush(sink);
+        if (fill_ == 0)
+            run_ = address;
+        return buffer_.get() + fill_;
+    }
+
+    template <class Sink>
+    void flush(Sink & sink)
+    {
+        if (fill_ > 0)
+            sink(run_, static_cast<const uint8_t *>(buffer_.get()), fill_);
+        fill_ = 0;
+    }
+
+    const uint8_t * fail(const uint8_t * at = nullptr)
+    {
+        error_ = std::make_error_code(std::errc::invalid_argument);
+        return at;
+    }
+
+    RecordFormat format_;
+    size_t capacity_;
+    std::unique_ptr<uint8_t[]> buffer_;
+    // Data of the run at address run_ not yet passed to the sink
+    size_t fill_ = 0;
+    uint32_t run_ = 0;
+    // Segment or linear base address of the Intel HEX data records
+    uint32_t base_ = 0;
+    std::optional<uint32_t> start_;
+    bool ended_ = false;
+    std::error_code error_;
+    size_t line_ = 1;
+    // Digits and value of the count of the last record
+    uint16_t count_digits_ = 0;
+    size_t count_ = 0;
+    // The start of a record that continues in the next chunk
+    uint8_t carry_[heks_detail::record_line_max];
+    size_t carry_size_ = 0;
+};
+
+// Intel HEX of a whole image: len bytes of src at address, then the end of file record
+inline size_t ihex_encoded_size(size_t len, const RecordOptions & options = {})
+{
+    return RecordEncoder(RecordFormat::IntelHex, options).max_encoded_size(len);
+}
+
+inline size_t ihex_encode(uint8_t * dest, const uint8_t * src, size_t len, uint32_t address = 0, const RecordOptions & options = {})
+{
+    RecordEncoder encoder(RecordFormat::IntelHex, options);
+    const size_t size = encoder.encode(dest, src, len, address);
+    return size + encoder.finish(dest + size);
+}
+
+// S-records of a whole image: len bytes of src at address, then the S7/S8/S9 termination record
+inline size_t srec_encoded_size(size_t len, const RecordOptions & options = {})
+{
+    return RecordEncoder(RecordFormat::SRecord, options).max_encoded_size(len);
+}
+
+inline size_t srec_encode(uint8_t * dest, const uint8_t * src, size_t len, uint32_t address = 0, const RecordOptions & options = {})
+{
+    RecordEncoder encoder(RecordFormat::SRecord, options);
+    const size_t size = encoder.encode(dest, src, len, address);
+    return size + encoder.finish(dest + size);
+}
+
+// The data of a whole Intel HEX / S-record text to sink(uint32_t address, const uint8_t * data, size_t size)
+template <class Sink>
+std::error_code ihex_decode(const uint8_t * text, size_t len, Sink && sink)
+{
+    RecordDecoder decoder(RecordFormat::IntelHex);
+    decoder.decode(text, len, sink);
+    return decoder.finish(sink);
+}
+
+template <class Sink>
+std::error_code srec_decode(const uint8_t * text, size_t len, Sink && sink)
+{
+    RecordDecoder decoder(RecordFormat::SRecord);
+    decoder.decode(text, len, sink);
+    return decoder.finish(sink);
+}
+
+FAST_HEX_NAMESPACE_CLOSE
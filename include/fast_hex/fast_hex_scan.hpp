@@ -0,0 +1,238 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Finds runs of hex digits (hashes, trace IDs, addresses) in arbitrary text, for log processing where a
+// regex engine would otherwise do the extraction.
+//
+// 64 bytes at a time are classified into a bitmask of hex digits (two AVX2 compares per 32 bytes, NEON
+// compares narrowed with pairwise adds, or SWAR range checks). Runs shorter than min_len are eroded away
+// with shifts and ands, and the boundaries of the rest are taken out of the masks with countr_zero (tzcnt).
+//
+//   heks::find_hex_runs(line, size, 16, [&](heks::HexRun run) { ids.emplace_back(line + run.offset, run.length); });
+
+FAST_HEX_NAMESPACE_OPEN
+
+struct HexRun
+{
+    // Offset of the first digit in the text and number of digits
+    size_t offset;
+    size_t length;
+};
+
+namespace heks_detail
+{
+
+// '0'-'9', 'a'-'f' or 'A'-'F': the characters unhexBitManip (and so decodeHexVec) decodes correctly
+constexpr bool isHexDigit(uint8_t c)
+{
+    return static_cast<uint8_t>(c - '0') < 10 || static_cast<uint8_t>((c | 0x20) - 'a') < 6;
+}
+
+// Bit k set if byte k of chars is a hex digit. The range checks run on the low 7 bits of every byte with
+// bit 7 set, so that subtracting at most 0x7F never borrows from the next byte.
+constexpr uint64_t hexDigitMaskSWAR(uint64_t chars)
+{
+    constexpr uint64_t ones = 0x0101010101010101;
+    const uint64_t low7 = (chars & (ones * 0x7F)) | (ones * 0x80);
+    const uint64_t folded = low7 | (ones * 0x20);
+    const uint64_t digit = (low7 - ones * '0') & ~(low7 - ones * ('9' + 1));
+    const uint64_t letter = (folded - ones * 'a') & ~(folded - ones * ('f' + 1));
+    const uint64_t hex = (digit | letter) & ~chars & (ones * 0x80);
+    // Bit 7 of byte k to bit 56 + k
+    return ((hex >> 7) * 0x0102040810204080) >> 56;
+}
+
+// Bit k set if text[k] is a hex digit, for the 64 bytes from text
+inline uint64_t hexDigitMask(const uint8_t * text)
+{
+    uint64_t mask = 0;
+    for (size_t k = 0; k < 8; ++k)
+        mask |= hexDigitMaskSWAR(loadLE64(text + k * 8)) << (k * 8);
+    return mask;
+}
+
+#if defined(FAST_HEX_AVX2)
+// 0xFF in the bytes of chars that are hex digits, 0 elsewhere
+__attribute__((target("avx2"))) inline __m256i hexDigitBytes(__m256i chars)
+{
+    // c - '0' <= 9 or (c | 0x20) - 'a' <= 5 unsigned, as x == min(x, limit)
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    return _mm256_or_si256(is_digit, is_letter);
+}
+
+__attribute__((target("avx2"))) inline uint32_t hexDigitMask(__m256i chars)
+{
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hexDigitBytes(chars)));
+}
+
+__attribute__((target("avx2"))) inline uint64_t hexDigitMaskVec(const uint8_t * text)
+{
+    const uint32_t lo = hexDigitMask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text)));
+    const uint32_t hi = hexDigitMask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + 32)));
+    return lo | (uint64_t{hi} << 32);
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+// Bit k set if byte k of bytes (0xFF or 0) is set: the movemask NEON does not have
+inline uint16_t byteMask(uint8x16_t bytes)
+{
+    alignas(16) constexpr uint8_t bits[] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weighted = vandq_u8(bytes, vld1q_u8(bits));
+    // Three pairwise adds sum the 8 weights of each half into bytes 0 and 1
+    uint8x8_t sum = vpadd_u8(vget_low_u8(weighted), vget_high_u8(weighted));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+    return vget_lane_u16(vreinterpret_u16_u8(sum), 0);
+}
+
+// 0xFF in the bytes of chars that are hex digits, 0 elsewhere
+inline uint8x16_t hexDigitBytes(uint8x16_t chars)
+{
+    const uint8x16_t digit = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(9));
+    const uint8x16_t letter = vcleq_u8(vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(5));
+    return vorrq_u8(digit, letter);
+}
+
+inline uint16_t hexDigitMask(uint8x16_t chars)
+{
+    return byteMask(hexDigitBytes(chars));
+}
+
+inline uint64_t hexDigitMaskNeon(const uint8_t * text)
+{
+    uint64_t mask = 0;
+    for (size_t k = 0; k < 4; ++k)
+        mask |= uint64_t{hexDigitMask(vld1q_u8(text + k * 16))} << (k * 16);
+    return mask;
+}
+#endif // FAST_HEX_NEON
+
+template <uint64_t (*Mask)(const uint8_t *), class Callback>
+size_t findHexRunsImpl(const uint8_t * text, size_t length, size_t min_len, Callback && callback)
+{
+    const auto mask_at = [&](size_t base)
+    {
+        if (base + 64 <= length)
+            return Mask(text + base);
+        uint64_t mask = 0;
+        for (size_t k = 0; base + k < length; ++k)
+            mask |= uint64_t{isHexDigit(text[base + k])} << k;
+        return mask;
+    };
+    // Runs are reported from their first digit if it starts span digits in a row, so the many short runs of
+    // ordinary words ("add", "be") are dropped by the mask arithmetic below, before any countr_zero
+    const size_t span = std::clamp<size_t>(min_len, 1, 64);
+
+    size_t runs = 0;
+    size_t start = 0;
+    bool in_run = false;
+    const auto end_run = [&](size_t end)
+    {
+        if (end - start >= min_len)
+        {
+            callback(HexRun{start, end - start});
+            ++runs;
+        }
+    };
+
+    // Top bit of the previous block's mask
+    uint64_t carry = 0;
+    uint64_t mask = length > 0 ? mask_at(0) : 0;
+    for (size_t base = 0; base < length; base += 64)
+    {
+        const uint64_t next = base + 64 < length ? mask_at(base + 64) : 0;
+
+        // Erosion: bit k of long_runs is set if the span digits from base + k are all hex. The 128-bit
+        // window (mask, next) covers them for any k, as span is at most 64.
+        uint64_t long_runs = mask;
+        uint64_t upper = next;
+        for (size_t covered = 1; covered < span;)
+        {
+            const size_t shift = std::min(covered, span - covered);
+            long_runs &= (long_runs >> shift) | (upper << (64 - shift));
+            upper &= upper >> shift;
+            covered += shift;
+        }
+
+        if (in_run)
+        {
+            if (mask == ~uint64_t{0})
+            {
+                carry = 1;
+                mask = next;
+                continue;
+            }
+            end_run(base + static_cast<size_t>(std::countr_zero(~mask)));
+            in_run = false;
+        }
+        // Digits with a non-digit before them, long enough; every run ends before the next one starts
+        for (uint64_t starts = long_runs & ~((mask << 1) | carry); starts != 0; starts &= starts - 1)
+        {
+            const int first = std::countr_zero(starts);
+            start = base + static_cast<size_t>(first);
+            const uint64_t gaps = ~mask & (~uint64_t{0} << first);
+            if (gaps == 0)
+            {
+                in_run = true;
+                break;
+            }
+            end_run(base + static_cast<size_t>(std::countr_zero(gaps)));
+        }
+        carry = mask >> 63;
+        mask = next;
+    }
+    if (in_run)
+        end_run(length);
+    return runs;
+}
+
+} // namespace heks_detail
+
+// Calls callback(HexRun) for every maximal run of at least min_len hex digits (either case) in the length
+// bytes of text, in order. Returns the number of runs reported.
+template <class Callback>
+size_t find_hex_runs(const uint8_t * text, size_t length, size_t min_len, Callback && callback)
+{
+#if defined(FAST_HEX_AVX2)
+    return heks_detail::findHexRunsImpl<heks_detail::hexDigitMaskVec>(text, length, min_len, callback);
+#elif defined(FAST_HEX_NEON)
+    return heks_detail::findHexRunsImpl<heks_detail::hexDigitMaskNeon>(text, length, min_len, callback);
+#else
+    return heks_detail::findHexRunsImpl<heks_detail::hexDigitMask>(text, length, min_len, callback);
+#endif
+}
+
+// As find_hex_runs, decoding every run with decode_auto and calling callback(HexRun, const uint8_t * bytes,
+// size_t size). A run of odd length decodes as if it had a leading '0', like a number. The bytes of the
+// runs are written one after the other into dest, which must hold (length + 1) / 2 bytes.
+template <class Callback>
+size_t decode_hex_runs(uint8_t * FAST_HEX_RESTRICT dest, const uint8_t * FAST_HEX_RESTRICT text, size_t length, size_t min_len, Callback && callback)
+{
+    uint8_t * out = dest;
+    return find_hex_runs(
+        text,
+        length,
+        min_len,
+        [&](HexRun run)
+        {
+            const uint8_t * digits = text + run.offset;
+            uint8_t * bytes = out;
+            if (run.length % 2 != 0)
+                *out++ = heks_detail::unhexB(*digits++);
+            decode_auto(out, digits, RawLength{run.length / 2});
+            out += run.length / 2;
+            callback(run, static_cast<const uint8_t *>(bytes), static_cast<size_t>(out - bytes));
+        });
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,180 @@
+#pragma once
+
+// Types of the hot-path statistics (FAST_HEX_STATS, CMake option fast_hex_ENABLE_STATS).
+// Included by fast_hex.hpp and fast_hex_inline.hpp, which define the namespace macros.
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+FAST_HEX_NAMESPACE_OPEN
+
+// Instrumented public entry points, followed by the fallbacks taken inside them
+enum class StatsPath : uint8_t
+{
+    DecodeHexLUT,
+    DecodeHexLUT4,
+    DecodeHexBMI,
+    DecodeHexVec,
+    DecodeHexVecMaddubs,
+    DecodeHexSWAR,
+    DecodeHexGeneric,
+    DecodeHexBMI16,
+    DecodeHexVec16,
+    DecodeHexNeon16,
+    EncodeHexLower,
+    EncodeHexUpper,
+    EncodeHexLowerSWAR,
+    EncodeHexUpperSWAR,
+    EncodeHexLowerGeneric,
+    EncodeHexUpperGeneric,
+    EncodeHexLower16,
+    EncodeHexUpper16,
+    EncodeHexLower32,
+    EncodeHexUpper32,
+    EncodeHexLowerVec,
+    EncodeHexUpperVec,
+    EncodeHexLowerVec16,
+    EncodeHexUpperVec16,
+    EncodeHexLowerVec32,
+    EncodeHexUpperVec32,
+    EncodeHex8LowerFast,
+    EncodeHex8UpperFast,
+    EncodeHex16LowerFast,
+    EncodeHex16UpperFast,
+    EncodeHexNeonLower,
+    EncodeHexNeonUpper,
+    EncodeHexNeonLower16,
+    EncodeHexNeonUpper16,
+    EncodeHexNeonLower32,
+    EncodeHexNeonUpper32,
+    EncodeHex8LowerNeon,
+    EncodeHex8UpperNeon,
+    EncodeHex16LowerNeon,
+    EncodeHex16UpperNeon,
+    DecodeHex8Fast,
+    DecodeHex16Fast,
+    DecodeHex32Fast,
+    DecodeHex8Neon,
+    DecodeHex16Neon,
+    DecodeHex32Neon,
+    EncodeAuto,
+    EncodeAuto16,
+    EncodeAuto32,
+    DecodeAuto,
+    DecodeAuto16,
+    // Fallbacks, counted with the length they handle
+    DecodeHexVecTail, // remainder (< 32 bytes) of decodeHexVec decoded by the BMI loop
+    EncodeHexVecTail, // remainder (< 16 bytes) of the AVX2 encoder done by the scalar table loop
+    EncodeHexNeonTail, // remainder (< 16 bytes) of the NEON encoder done by the scalar table loop
+    DecodeHexVec16Tail, // remainder (< 32 bytes) of decodeHexVec16 decoded by the scalar UTF-16 loop
+    DecodeHexNeon16Tail, // remainder (< 16 bytes) of decodeHexNeon16 decoded by the scalar UTF-16 loop
+    EncodeHexVec16Tail, // remainder (< 16 bytes) of encodeHex*Vec16 done by the scalar widening loop
+    EncodeHexVec32Tail, // remainder (< 16 bytes) of encodeHex*Vec32 done by the scalar widening loop
+    EncodeHexNeon16Tail, // remainder (< 16 bytes) of encodeHexNeon*16 done by the scalar widening loop
+    EncodeHexNeon32Tail, // remainder (< 16 bytes) of encodeHexNeon*32 done by the scalar widening loop
+    EncodeHexGenericTail, // remainder (< 16 bytes) of encodeHex*Generic done by the SWAR loop
+    DecodeHexGenericTail, // remainder (< 16 bytes) of decodeHexGeneric decoded by the SWAR loop
+    DecodeHexVecMaddubsTail, // remainder (< 32 bytes) of decodeHexVecMaddubs decoded by the BMI loop
+    Count
+};
+
+inline constexpr size_t stats_path_count = static_cast<size_t>(StatsPath::Count);
+
+inline constexpr std::string_view stats_path_names[stats_path_count] = {
+    "decodeHexLUT",
+    "decodeHexLUT4",
+    "decodeHexBMI",
+    "decodeHexVec",
+    "decodeHexVecMaddubs",
+    "decodeHexSWAR",
+    "decodeHexGeneric",
+    "decodeHexBMI16",
+    "decodeHexVec16",
+    "decodeHexNeon16",
+    "encodeHexLower",
+    "encodeHexUpper",
+    "encodeHexLowerSWAR",
+    "encodeHexUpperSWAR",
+    "encodeHexLowerGeneric",
+    "encodeHexUpperGeneric",
+    "encodeHexLower16",
+    "encodeHexUpper16",
+    "encodeHexLower32",
+    "encodeHexUpper32",
+    "encodeHexLowerVec",
+    "encodeHexUpperVec",
+    "encodeHexLowerVec16",
+    "encodeHexUpperVec16",
+    "encodeHexLowerVec32",
+    "encodeHexUpperVec32",
+    "encodeHex8LowerFast",
+    "encodeHex8UpperFast",
+    "encodeHex16LowerFast",
+    "encodeHex16UpperFast",
+    "encodeHexNeonLower",
+    "encodeHexNeonUpper",
+    "encodeHexNeonLower16",
+    "encodeHexNeonUpper16",
+    "encodeHexNeonLower32",
+    "encodeHexNeonUpper32",
+    "encodeHex8LowerNeon",
+    "encodeHex8UpperNeon",
+    "encodeHex16LowerNeon",
+    "encodeHex16UpperNeon",
+    "decodeHex8Fast",
+    "decodeHex16Fast",
+    "decodeHex32Fast",
+    "decodeHex8Neon",
+    "decodeHex16Neon",
+    "decodeHex32Neon",
+    "encode_auto",
+    "encode_auto16",
+    "encode_auto32",
+    "decode_auto",
+    "decode_auto16",
+    "decodeHexVec/tail",
+    "encodeHexVec/tail",
+    "encodeHexNeon/tail",
+    "decodeHexVec16/tail",
+    "decodeHexNeon16/tail",
+    "encodeHexVec16/tail",
+    "encodeHexVec32/tail",
+    "encodeHexNeon16/tail",
+    "encodeHexNeon32/tail",
+    "encodeHexGeneric/tail",
+    "decodeHexGeneric/tail",
+    "decodeHexVecMaddubs/tail",
+};
+
+constexpr std::string_view stats_path_name(StatsPath path)
+{
+    return stats_path_names[static_cast<size_t>(path)];
+}
+
+// Size histogram bucket of a raw length: bucket b holds [2^(b-1), 2^b), the last one everything above
+inline constexpr size_t stats_size_buckets = 32;
+
+constexpr size_t stats_size_bucket(size_t raw_length)
+{
+    const auto bucket = static_cast<size_t>(std::bit_width(raw_length));
+    return bucket < stats_size_buckets ? bucket : stats_size_buckets - 1;
+}
+
+struct StatsEntry
+{
+    uint64_t calls = 0;
+    uint64_t bytes = 0; // raw (binary) bytes, as RawLength
+    std::array<uint64_t, stats_size_buckets> sizes{};
+};
+
+struct StatsSnapshot
+{
+    std::array<StatsEntry, stats_path_count> paths{};
+
+    const StatsEntry & operator[](StatsPath path) const { return paths[static_cast<size_t>(path)]; }
+};
+
+FAST_HEX_NAMESPACE_CLOSE
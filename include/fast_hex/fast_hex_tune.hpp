@@ -0,0 +1,348 @@
+#pragma once
+
+#include "fast_hex_inline.hpp"
+
+#if !defined(FAST_HEX_TUNING)
+#    error "fast_hex_tune.hpp requires FAST_HEX_TUNING (CMake option fast_hex_ENABLE_TUNING)"
+#endif
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Startup auto-tuning of encode_auto/decode_auto.
+//
+// heks::tune() times every kernel available in this build on one representative length per size
+// bucket (see heks_detail::tune_bucket) and installs the fastest one per bucket. The result can be
+// cached in a text profile so that later runs skip the measurement:
+//
+//   heks::tune("/var/cache/myapp/heks.profile"); // load if valid for this build, otherwise measure and save
+//   std::puts(heks::dump_tuning(*heks::installed_tuning()).c_str());
+//
+// Until a table is installed (or after reset_tuning()) the *_auto functions use their built-in choice.
+
+FAST_HEX_NAMESPACE_OPEN
+
+namespace heks_detail
+{
+
+struct EncodeCandidate
+{
+    std::string_view name;
+    Kernel lower;
+    Kernel upper;
+};
+
+struct DecodeCandidate
+{
+    std::string_view name;
+    Kernel decode;
+};
+
+inline constexpr EncodeCandidate encode_candidates[] = {
+    {"encodeHex", &encodeHexImpl<HexCase::Lower>, &encodeHexImpl<HexCase::Upper>},
+    {"encodeHexSWAR", &encodeHexSWARImpl<HexCase::Lower>, &encodeHexSWARImpl<HexCase::Upper>},
+#if defined(FAST_HEX_GENERIC_SIMD)
+    {"encodeHexGeneric", &encodeHexGenericImpl<HexCase::Lower>, &encodeHexGenericImpl<HexCase::Upper>},
+#endif
+#if defined(FAST_HEX_AVX2)
+    {"encodeHexVec", &encodeHexVecImpl<HexCase::Lower>, &encodeHexVecImpl<HexCase::Upper>},
+#endif
+#if defined(FAST_HEX_NEON)
+    {"encodeHexNeon", &encodeHexNeon_impl<HexCase::Lower>, &encodeHexNeon_impl<HexCase::Upper>},
+#endif
+};
+
+inline constexpr DecodeCandidate decode_candidates[] = {
+    {"decodeHexLUT", &decodeHexLUTImpl},
+    {"decodeHexLUT4", &decodeHexLUT4Impl},
+    {"decodeHexBMI", &decodeHexBMIImpl},
+    {"decodeHexSWAR", &decodeHexSWARImpl},
+#if defined(FAST_HEX_GENERIC_SIMD)
+    {"decodeHexGeneric", &decodeHexGenericImpl},
+#endif
+#if defined(FAST_HEX_AVX2)
+    {"decodeHexVec", &decodeHexVecImpl},
+    {"decodeHexVecMaddubs", &decodeHexVecMaddubsImpl},
+#endif
+};
+
+// Length measured for a bucket: the geometric middle of its range
+constexpr size_t tune_length(size_t bucket)
+{
+    return bucket < 2 ? bucket : size_t{3} << (bucket - 2);
+}
+
+inline void tune_clobber(void * p)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(p) : "memory");
+#else
+    static void * volatile sink;
+    sink = p;
+#endif
+}
+
+// Best observed time of one call, in seconds
+inline double time_kernel(Kernel kernel, uint8_t * dest, const uint8_t * src, size_t raw_length, std::chrono::nanoseconds budget)
+{
+    using clock = std::chrono::steady_clock;
+    auto run_batch = [&](size_t batch)
+    {
+        const auto start = clock::now();
+        for (size_t i = 0; i < batch; ++i)
+        {
+            kernel(dest, src, RawLength{raw_length});
+            tune_clobber(dest);
+        }
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    // Grow the batch until a round is long enough to be timed reliably (this also warms up)
+    const double round = std::chrono::duration<double>(budget).count() / 16;
+    size_t batch = 1;
+    while (run_batch(batch) < round && batch < (size_t{1} << 20))
+        batch *= 2;
+
+    double best = std::numeric_limits<double>::infinity();
+    const auto deadline = clock::now() + budget;
+    do
+        best = std::min(best, run_batch(batch) / static_cast<double>(batch));
+    while (clock::now() < deadline);
+    return best;
+}
+
+template <typename Candidate, size_t N>
+std::optional<uint8_t> find_candidate(const Candidate (&candidates)[N], std::string_view name)
+{
+    for (size_t i = 0; i < N; ++i)
+        if (candidates[i].name == name)
+            return static_cast<uint8_t>(i);
+    return std::nullopt;
+}
+
+} // namespace heks_detail
+
+// Index of the chosen kernel per size bucket, into heks_detail::encode_candidates / decode_candidates
+struct TuneTable
+{
+    std::array<uint8_t, heks_detail::tune_buckets> encode{};
+    std::array<uint8_t, heks_detail::tune_buckets> decode{};
+
+    bool operator==(const TuneTable &) const = default;
+};
+
+struct TuneOptions
+{
+    // Measurement time per kernel and bucket
+    std::chrono::microseconds budget{200};
+};
+
+// Time all available kernels and return the fastest per bucket (encoders on lowercase and uppercase output
+// together). Does not install anything.
+inline TuneTable measure_tuning(const TuneOptions & options = {})
+{
+    using namespace heks_detail;
+    constexpr size_t max_length = tune_length(tune_buckets - 1);
+    std::vector<uint8_t> binary(max_length);
+    std::vector<uint8_t> hex(max_length * 2);
+    std::vector<uint8_t> out(max_length * 2);
+    for (size_t i = 0; i < max_length; ++i)
+        binary[i] = static_cast<uint8_t>(i * 37 + 11);
+    encodeHexImpl<HexCase::Lower>(hex.data(), binary.data(), RawLength{max_length});
+
+    TuneTable table;
+    // Bucket 0 only holds the empty input, there is nothing to measure
+    for (size_t bucket = 1; bucket < tune_buckets; ++bucket)
+    {
+        const size_t length = tune_length(bucket);
+        double best = std::numeric_limits<double>::infinity();
+        // One kernel serves both cases in the table: pick it on the sum of both, half the budget each
+        for (size_t i = 0; i < std::size(encode_candidates); ++i)
+        {
+            const auto half = options.budget / 2;
+            const double t = time_kernel(encode_candidates[i].lower, out.data(), binary.data(), length, half)
+                + time_kernel(encode_candidates[i].upper, out.data(), binary.data(), length, half);
+            if (t < best)
+            {
+                best = t;
+                table.encode[bucket] = static_cast<uint8_t>(i);
+            }
+        }
+        best = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < std::size(decode_candidates); ++i)
+        {
+            const double t = time_kernel(decode_candidates[i].decode, out.data(), hex.data(), length, options.budget);
+            if (t < best)
+            {
+                best = t;
+                table.decode[bucket] = static_cast<uint8_t>(i);
+            }
+        }
+    }
+    return table;
+}
+
+namespace heks_detail
+{
+struct InstalledTuning
+{
+    DispatchTable dispatch;
+    TuneTable table;
+};
+
+struct TuningRegistry
+{
+    std::mutex mutex;
+    // Replaced tables are kept alive: a concurrent *_auto call may still be using one
+    std::vector<std::unique_ptr<InstalledTuning>> tables;
+    const InstalledTuning * current = nullptr;
+};
+
+inline TuningRegistry & tuning_registry()
+{
+    static TuningRegistry registry;
+    return registry;
+}
+} // namespace heks_detail
+
+// Make encode_auto/decode_auto use the given table. Indices must be valid for this build.
+inline void install_tuning(const TuneTable & table)
+{
+    using namespace heks_detail;
+    auto installed = std::make_unique<InstalledTuning>();
+    installed->table = table;
+    for (size_t bucket = 0; bucket < tune_buckets; ++bucket)
+    {
+        const auto & encode = encode_candidates[table.encode[bucket]];
+        installed->dispatch.encode_lower[bucket] = encode.lower;
+        installed->dispatch.encode_upper[bucket] = encode.upper;
+        installed->dispatch.decode[bucket] = decode_candidates[table.decode[bucket]].decode;
+    }
+
+    auto & registry = tuning_registry();
+    const std::lock_guard lock(registry.mutex);
+    registry.current = installed.get();
+    tuned_dispatch.store(&installed->dispatch, std::memory_order_release);
+    registry.tables.push_back(std::move(installed));
+}
+
+// Go back to the built-in kernel choice
+inline void reset_tuning()
+{
+    using namespace heks_detail;
+    auto & registry = tuning_registry();
+    const std::lock_guard lock(registry.mutex);
+    registry.current = nullptr;
+    tuned_dispatch.store(nullptr, std::memory_order_release);
+}
+
+inline std::optional<TuneTable> installed_tuning()
+{
+    auto & registry = heks_detail::tuning_registry();
+    const std::lock_guard lock(registry.mutex);
+    if (registry.current == nullptr)
+        return std::nullopt;
+    return registry.current->table;
+}
+
+// One line per bucket: bucket, smallest and largest raw length, encode kernel, decode kernel.
+// This is also the profile file format.
+inline std::string dump_tuning(const TuneTable & table)
+{
+    using namespace heks_detail;
+    std::ostringstream out;
+    out << "# heks tuning: bucket min_len max_len encode decode\n";
+    for (size_t bucket = 0; bucket < tune_buckets; ++bucket)
+    {
+        const size_t min_length = bucket == 0 ? 0 : size_t{1} << (bucket - 1);
+        out << bucket << ' ' << min_length << ' ';
+        if (bucket + 1 == tune_buckets)
+            out << '-';
+        else
+            out << (size_t{1} << bucket) - 1;
+        out << ' ' << encode_candidates[table.encode[bucket]].name << ' ' << decode_candidates[table.decode[bucket]].name << '\n';
+    }
+    return out.str();
+}
+
+// Parse the output of dump_tuning(). Fails if a bucket is missing or names a kernel not available in this build.
+inline std::optional<TuneTable> parse_tuning(std::string_view text)
+{
+    using namespace heks_detail;
+    TuneTable table;
+    std::array<bool, tune_buckets> seen{};
+    std::istringstream in{std::string(text)};
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        size_t bucket = 0;
+        std::string min_length, max_length, encode, decode, extra;
+        if (!(fields >> bucket >> min_length >> max_length >> encode >> decode) || (fields >> extra) || bucket >= tune_buckets)
+            return std::nullopt;
+        const auto encode_index = find_candidate(encode_candidates, encode);
+        const auto decode_index = find_candidate(decode_candidates, decode);
+        if (!encode_index || !decode_index)
+            return std::nullopt;
+        table.encode[bucket] = *encode_index;
+        table.decode[bucket] = *decode_index;
+        seen[bucket] = true;
+    }
+    for (bool bucket_seen : seen)
+        if (!bucket_seen)
+            return std::nullopt;
+    return table;
+}
+
+inline bool save_tuning(const TuneTable & table, const std::string & path)
+{
+    std::ofstream out(path, std::ios::trunc);
+    out << dump_tuning(table);
+    out.close();
+    return !out.fail();
+}
+
+inline std::optional<TuneTable> load_tuning(const std::string & path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return std::nullopt;
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parse_tuning(text.str());
+}
+
+// Measure and install
+inline TuneTable tune(const TuneOptions & options = {})
+{
+    const auto table = measure_tuning(options);
+    install_tuning(table);
+    return table;
+}
+
+// Install the profile at profile_path if it is valid for this build, otherwise measure, install and
+// (try to) save it there
+inline TuneTable tune(const std::string & profile_path, const TuneOptions & options = {})
+{
+    if (const auto cached = load_tuning(profile_path))
+    {
+        install_tuning(*cached);
+        return *cached;
+    }
+    const auto table = tune(options);
+    save_tuning(table, profile_path);
+    return table;
+}
+
+FAST_HEX_NAMESPACE_CLOSE
@@ -0,0 +1,505 @@
+// Node-API addon over fast_hex_inline.hpp (see binding.gyp and test.js).
+//
+// encode(src[, upper])            -> string      src: Buffer/TypedArray/ArrayBuffer
+// encodeInto(src, dest[, upper])  -> number      hex characters written into dest (no copies)
+// decode(hex)                     -> Buffer      hex: string or Buffer/TypedArray/ArrayBuffer of characters
+// decodeInto(hex, dest)           -> number      bytes written into dest (no copies)
+// encodeAsync / decodeAsync       -> Promise     as above; inputs of at least asyncThreshold bytes are
+//                                                processed on the libuv threadpool
+// setAsyncThreshold(bytes)        -> number      previous threshold (per thread: main or worker_thread)
+//
+// Decoding does not validate its input (invalid characters give unspecified bytes), like the C++ API.
+// V8 owns string memory, so producing or consuming a string costs one copy; Buffers are used in place.
+// Inputs and destinations of pending async calls must not be modified or transferred.
+
+#if defined(__AVX__) && !defined(FAST_HEX_AVX)
+#    define FAST_HEX_AVX 1
+#endif
+#if defined(__AVX2__) && !defined(FAST_HEX_AVX2)
+#    define FAST_HEX_AVX2 1
+#endif
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(FAST_HEX_NEON)
+#    define FAST_HEX_NEON 1
+#endif
+#if !defined(FAST_HEX_USE_NAMESPACE)
+#    define FAST_HEX_USE_NAMESPACE 1
+#endif
+
+#include "fast_hex/fast_hex_inline.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <node_api.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+// Throw the pending napi error (if no JS exception is already pending) and return nullptr
+#define NAPI_CALL(env, call) \
+    do \
+    { \
+        if ((call) != napi_ok) \
+        { \
+            throw_last_error(env); \
+            return nullptr; \
+        } \
+    } while (0)
+
+void throw_last_error(napi_env env)
+{
+    bool pending = false;
+    napi_is_exception_pending(env, &pending);
+    if (pending)
+        return;
+    const napi_extended_error_info * info = nullptr;
+    napi_get_last_error_info(env, &info);
+    napi_throw_error(env, nullptr, info != nullptr && info->error_message != nullptr ? info->error_message : "napi call failed");
+}
+
+// Per environment (main thread or worker_thread) state, owned by napi_set_instance_data
+struct Instance
+{
+    size_t async_threshold = size_t{1} << 20;
+    std::vector<uint8_t> small; // reused by scratch()
+};
+
+Instance & instance(napi_env env)
+{
+    void * data = nullptr;
+    napi_get_instance_data(env, &data);
+    return *static_cast<Instance *>(data);
+}
+
+// Small strings are staged in the environment's reused buffer, large ones in a temporary allocation
+uint8_t * scratch(napi_env env, size_t size, std::unique_ptr<uint8_t[]> & large)
+{
+    constexpr size_t small_limit = size_t{64} << 10;
+    if (size > small_limit)
+    {
+        large.reset(new uint8_t[size]);
+        return large.get();
+    }
+    auto & small = instance(env).small;
+    if (small.size() < small_limit)
+        small.resize(small_limit);
+    return small.data();
+}
+
+struct Bytes
+{
+    uint8_t * data = nullptr;
+    size_t length = 0;
+};
+
+// Buffer, any TypedArray/DataView (its bytes) or ArrayBuffer
+bool get_bytes(napi_env env, napi_value value, Bytes & bytes)
+{
+    bool is = false;
+    if (napi_is_buffer(env, value, &is) == napi_ok && is)
+    {
+        void * data = nullptr;
+        if (napi_get_buffer_info(env, value, &data, &bytes.length) != napi_ok)
+            return false;
+        bytes.data = static_cast<uint8_t *>(data);
+        return true;
+    }
+    if (napi_is_typedarray(env, value, &is) == napi_ok && is)
+    {
+        napi_typedarray_type type;
+        size_t elements = 0;
+        void * data = nullptr;
+        napi_value buffer;
+        size_t offset = 0;
+        if (napi_get_typedarray_info(env, value, &type, &elements, &data, &buffer, &offset) != napi_ok)
+            return false;
+        size_t element_size = 1;
+        switch (type)
+        {
+            case napi_int16_array:
+            case napi_uint16_array:
+                element_size = 2;
+                break;
+            case napi_int32_array:
+            case napi_uint32_array:
+            case napi_float32_array:
+                element_size = 4;
+                break;
+            case napi_float64_array:
+            case napi_bigint64_array:
+            case napi_biguint64_array:
+                element_size = 8;
+                break;
+            default:
+                break;
+        }
+        bytes.data = static_cast<uint8_t *>(data);
+        bytes.length = elements * element_size;
+        return true;
+    }
+    if (napi_is_dataview(env, value, &is) == napi_ok && is)
+    {
+        void * data = nullptr;
+        napi_value buffer;
+        size_t offset = 0;
+        if (napi_get_dataview_info(env, value, &bytes.length, &data, &buffer, &offset) != napi_ok)
+            return false;
+        bytes.data = static_cast<uint8_t *>(data);
+        return true;
+    }
+    if (napi_is_arraybuffer(env, value, &is) == napi_ok && is)
+    {
+        void * data = nullptr;
+        if (napi_get_arraybuffer_info(env, value, &data, &bytes.length) != napi_ok)
+            return false;
+        bytes.data = static_cast<uint8_t *>(data);
+        return true;
+    }
+    return false;
+}
+
+bool is_string(napi_env env, napi_value value)
+{
+    napi_valuetype type;
+    return napi_typeof(env, value, &type) == napi_ok && type == napi_string;
+}
+
+bool get_upper(napi_env env, size_t argc, napi_value * argv, size_t index)
+{
+    bool upper = false;
+    if (index < argc)
+        napi_get_value_bool(env, argv[index], &upper); // non-booleans keep the default
+    return upper;
+}
+
+void encode_hex(uint8_t * dest, const uint8_t * src, size_t length, bool upper)
+{
+    if (upper)
+        encode_auto(dest, src, RawLength{length}, heks::upper);
+    else
+        encode_auto(dest, src, RawLength{length}, heks::lower);
+}
+
+// Hex characters of a decode argument. Strings are copied (latin1) into storage.
+bool get_hex(napi_env env, napi_value value, Bytes & hex, std::unique_ptr<uint8_t[]> & storage, bool owned)
+{
+    if (is_string(env, value))
+    {
+        size_t length = 0;
+        if (napi_get_value_string_latin1(env, value, nullptr, 0, &length) != napi_ok)
+        {
+            throw_last_error(env);
+            return false;
+        }
+        uint8_t * chars = nullptr;
+        if (owned)
+        {
+            storage.reset(new uint8_t[length + 1]);
+            chars = storage.get();
+        }
+        else
+            chars = scratch(env, length + 1, storage);
+        if (napi_get_value_string_latin1(env, value, reinterpret_cast<char *>(chars), length + 1, &length) != napi_ok)
+        {
+            throw_last_error(env);
+            return false;
+        }
+        hex = {chars, length};
+        return true;
+    }
+    if (get_bytes(env, value, hex))
+        return true;
+    napi_throw_type_error(env, nullptr, "hex input must be a string, Buffer, TypedArray or ArrayBuffer");
+    return false;
+}
+
+bool check_even(napi_env env, const Bytes & hex)
+{
+    if (hex.length % 2 == 0)
+        return true;
+    napi_throw_range_error(env, nullptr, "hex input must have an even length");
+    return false;
+}
+
+napi_value encode_string(napi_env env, const uint8_t * src, size_t length, bool upper)
+{
+    std::unique_ptr<uint8_t[]> large;
+    uint8_t * chars = scratch(env, length * 2, large);
+    encode_hex(chars, src, length, upper);
+    napi_value result;
+    NAPI_CALL(env, napi_create_string_latin1(env, reinterpret_cast<const char *>(chars), length * 2, &result));
+    return result;
+}
+
+napi_value Encode(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    Bytes src;
+    if (argc < 1 || !get_bytes(env, argv[0], src))
+    {
+        napi_throw_type_error(env, nullptr, "encode(src[, upper]): src must be a Buffer, TypedArray or ArrayBuffer");
+        return nullptr;
+    }
+    return encode_string(env, src.data, src.length, get_upper(env, argc, argv, 1));
+}
+
+napi_value EncodeInto(napi_env env, napi_callback_info info)
+{
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    Bytes src, dest;
+    if (argc < 2 || !get_bytes(env, argv[0], src) || !get_bytes(env, argv[1], dest))
+    {
+        napi_throw_type_error(env, nullptr, "encodeInto(src, dest[, upper]): src and dest must be Buffers, TypedArrays or ArrayBuffers");
+        return nullptr;
+    }
+    if (dest.length / 2 < src.length)
+    {
+        napi_throw_range_error(env, nullptr, "encodeInto: dest must hold twice the length of src");
+        return nullptr;
+    }
+    encode_hex(dest.data, src.data, src.length, get_upper(env, argc, argv, 2));
+    napi_value result;
+    NAPI_CALL(env, napi_create_double(env, static_cast<double>(src.length * 2), &result));
+    return result;
+}
+
+napi_value Decode(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    Bytes hex;
+    std::unique_ptr<uint8_t[]> storage;
+    if (argc < 1)
+    {
+        napi_throw_type_error(env, nullptr, "decode(hex): missing argument");
+        return nullptr;
+    }
+    if (!get_hex(env, argv[0], hex, storage, false) || !check_even(env, hex))
+        return nullptr;
+    void * data = nullptr;
+    napi_value result;
+    NAPI_CALL(env, napi_create_buffer(env, hex.length / 2, &data, &result));
+    decode_auto(static_cast<uint8_t *>(data), hex.data, RawLength{hex.length / 2});
+    return result;
+}
+
+napi_value DecodeInto(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    Bytes hex, dest;
+    std::unique_ptr<uint8_t[]> storage;
+    if (argc < 2 || !get_bytes(env, argv[1], dest))
+    {
+        napi_throw_type_error(env, nullptr, "decodeInto(hex, dest): dest must be a Buffer, TypedArray or ArrayBuffer");
+        return nullptr;
+    }
+    if (!get_hex(env, argv[0], hex, storage, false) || !check_even(env, hex))
+        return nullptr;
+    if (dest.length < hex.length / 2)
+    {
+        napi_throw_range_error(env, nullptr, "decodeInto: dest must hold half the length of hex");
+        return nullptr;
+    }
+    decode_auto(dest.data, hex.data, RawLength{hex.length / 2});
+    napi_value result;
+    NAPI_CALL(env, napi_create_double(env, static_cast<double>(hex.length / 2), &result));
+    return result;
+}
+
+// ---- Async ----
+
+struct AsyncJob
+{
+    bool decode = false;
+    bool upper = false;
+    const uint8_t * src = nullptr;
+    size_t length = 0; // raw length
+    std::unique_ptr<uint8_t[]> owned_src; // copied string input
+    uint8_t * dest = nullptr;
+    std::unique_ptr<uint8_t[]> owned_dest; // encode output, turned into a string on completion
+    napi_ref src_ref = nullptr; // keeps a Buffer input alive
+    napi_ref dest_ref = nullptr; // the Buffer decode resolves with
+    napi_deferred deferred = nullptr;
+    napi_async_work work = nullptr;
+
+    void run() const
+    {
+        if (decode)
+            decode_auto(dest, src, RawLength{length});
+        else
+            encode_hex(dest, src, length, upper);
+    }
+};
+
+napi_value job_result(napi_env env, AsyncJob & job)
+{
+    napi_value result;
+    if (job.decode)
+        NAPI_CALL(env, napi_get_reference_value(env, job.dest_ref, &result));
+    else
+        NAPI_CALL(env, napi_create_string_latin1(env, reinterpret_cast<const char *>(job.dest), job.length * 2, &result));
+    return result;
+}
+
+// Settles the promise: rejected if the work did not run (napi_cancelled) or its result could not be created
+void finish(napi_env env, AsyncJob * job, napi_status status)
+{
+    napi_value result = status == napi_ok ? job_result(env, *job) : nullptr;
+    if (result != nullptr)
+        napi_resolve_deferred(env, job->deferred, result);
+    else
+    {
+        napi_value error = nullptr;
+        if (status != napi_ok)
+        {
+            napi_value message;
+            if (napi_create_string_utf8(env, "heks: async work was cancelled", NAPI_AUTO_LENGTH, &message) == napi_ok)
+                napi_create_error(env, nullptr, message, &error);
+        }
+        else
+            napi_get_and_clear_last_exception(env, &error);
+        if (error == nullptr)
+            napi_get_undefined(env, &error);
+        napi_reject_deferred(env, job->deferred, error);
+    }
+    if (job->src_ref != nullptr)
+        napi_delete_reference(env, job->src_ref);
+    if (job->dest_ref != nullptr)
+        napi_delete_reference(env, job->dest_ref);
+    if (job->work != nullptr)
+        napi_delete_async_work(env, job->work);
+    delete job;
+}
+
+void execute(napi_env, void * data)
+{
+    static_cast<AsyncJob *>(data)->run();
+}
+
+void complete(napi_env env, napi_status status, void * data)
+{
+    finish(env, static_cast<AsyncJob *>(data), status);
+}
+
+// Runs the job inline below the threshold, otherwise queues it on the threadpool
+napi_value start(napi_env env, std::unique_ptr<AsyncJob> job, napi_value src)
+{
+    napi_value promise;
+    NAPI_CALL(env, napi_create_promise(env, &job->deferred, &promise));
+    if (job->length < instance(env).async_threshold)
+    {
+        job->run();
+        finish(env, job.release(), napi_ok);
+        return promise;
+    }
+    if (!job->owned_src)
+        NAPI_CALL(env, napi_create_reference(env, src, 1, &job->src_ref));
+    napi_value name;
+    NAPI_CALL(env, napi_create_string_utf8(env, "heks", NAPI_AUTO_LENGTH, &name));
+    NAPI_CALL(env, napi_create_async_work(env, nullptr, name, execute, complete, job.get(), &job->work));
+    NAPI_CALL(env, napi_queue_async_work(env, job->work));
+    job.release();
+    return promise;
+}
+
+napi_value EncodeAsync(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    Bytes src;
+    if (argc < 1 || !get_bytes(env, argv[0], src))
+    {
+        napi_throw_type_error(env, nullptr, "encodeAsync(src[, upper]): src must be a Buffer, TypedArray or ArrayBuffer");
+        return nullptr;
+    }
+    auto job = std::make_unique<AsyncJob>();
+    job->upper = get_upper(env, argc, argv, 1);
+    job->src = src.data;
+    job->length = src.length;
+    job->owned_dest.reset(new uint8_t[src.length * 2 + 1]);
+    job->dest = job->owned_dest.get();
+    return start(env, std::move(job), argv[0]);
+}
+
+napi_value DecodeAsync(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    if (argc < 1)
+    {
+        napi_throw_type_error(env, nullptr, "decodeAsync(hex): missing argument");
+        return nullptr;
+    }
+    auto job = std::make_unique<AsyncJob>();
+    job->decode = true;
+    Bytes hex;
+    if (!get_hex(env, argv[0], hex, job->owned_src, true) || !check_even(env, hex))
+        return nullptr;
+    job->src = hex.data;
+    job->length = hex.length / 2;
+
+    void * data = nullptr;
+    napi_value dest;
+    NAPI_CALL(env, napi_create_buffer(env, job->length, &data, &dest));
+    NAPI_CALL(env, napi_create_reference(env, dest, 1, &job->dest_ref));
+    job->dest = static_cast<uint8_t *>(data);
+    return start(env, std::move(job), argv[0]);
+}
+
+napi_value SetAsyncThreshold(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    double threshold = 0;
+    if (argc < 1 || napi_get_value_double(env, argv[0], &threshold) != napi_ok || !(threshold >= 0))
+    {
+        napi_throw_type_error(env, nullptr, "setAsyncThreshold(bytes): bytes must be a non-negative number");
+        return nullptr;
+    }
+    napi_value previous;
+    auto & async_threshold = instance(env).async_threshold;
+    NAPI_CALL(env, napi_create_double(env, static_cast<double>(async_threshold), &previous));
+    // Infinity (or anything too large) disables offloading
+    async_threshold = threshold >= static_cast<double>(SIZE_MAX) ? SIZE_MAX : static_cast<size_t>(threshold);
+    return previous;
+}
+
+napi_value Init(napi_env env, napi_value exports)
+{
+    // Each environment loading the addon gets its own threshold and scratch buffer
+    auto state = std::make_unique<Instance>();
+    auto release = [](napi_env, void * data, void *) { delete static_cast<Instance *>(data); };
+    NAPI_CALL(env, napi_set_instance_data(env, state.get(), release, nullptr));
+    state.release();
+    const napi_property_descriptor properties[] = {
+        {"encode", nullptr, Encode, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"encodeInto", nullptr, EncodeInto, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"decode", nullptr, Decode, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"decodeInto", nullptr, DecodeInto, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"encodeAsync", nullptr, EncodeAsync, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"decodeAsync", nullptr, DecodeAsync, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+        {"setAsyncThreshold", nullptr, SetAsyncThreshold, nullptr, nullptr, nullptr, napi_enumerable, nullptr},
+    };
+    NAPI_CALL(env, napi_define_properties(env, exports, std::size(properties), properties));
+    return exports;
+}
+
+} // namespace
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -1,28 +1,110 @@
-const pkg = require(".");
+const heks = require(".");
 const assert = require("assert");
+const {Worker, isMainThread, parentPort} = require("worker_threads");
 
-const inp = Buffer.from([
-	128,0,48,192,47,52,0,0,
-	0,0,0,0,0,0,0,0,
-	0,0,0,08,0,0,0,156,
-	1,0,0,140,2,0,0,0,
-	0,0,0,0,0,32,0,00,
-	96,46,99
-]);
+function pattern(length) {
+	const buf = Buffer.alloc(length);
+	for (let i = 0; i < length; i++) buf[i] = (i * 37 + 11) & 0xff;
+	return buf;
+}
 
-const a = pkg.encodeHex(inp);
-const b = pkg.encodeHexVec(inp);
+// worker_threads: strings staged in the scratch buffer while other threads use theirs, and a threshold of their own
+if (!isMainThread) {
+	assert.strictEqual(heks.setAsyncThreshold(7), 1 << 20);
+	for (let i = 0; i < 2000; i++) {
+		const input = pattern(1 + ((i * 97) % 3000)).map((byte) => byte ^ i);
+		const hex = input.toString("hex");
+		assert.strictEqual(heks.encode(input), hex);
+		assert.deepStrictEqual(heks.decode(hex), input);
+	}
+	parentPort.postMessage("done");
+	return;
+}
 
-assert.deepStrictEqual(a, b);
+const lengths = [0, 1, 2, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 255, 1000, 4097, 70000];
+
+// encode / encodeInto
+for (const length of lengths) {
+	const input = pattern(length);
+	const expected = input.toString("hex");
+	assert.strictEqual(heks.encode(input), expected, `encode ${length}`);
+	assert.strictEqual(heks.encode(input, true), expected.toUpperCase(), `encode upper ${length}`);
+
+	const dest = Buffer.alloc(length * 2 + 3, 0x2a);
+	assert.strictEqual(heks.encodeInto(input, dest), length * 2);
+	assert.strictEqual(dest.toString("latin1", 0, length * 2), expected);
+	assert.strictEqual(dest.toString("latin1", length * 2), "***", "encodeInto writes past the output");
+}
+
+// Other byte sources: TypedArray views (with offsets), ArrayBuffer, DataView
+{
+	const input = pattern(40);
+	const view = new Uint8Array(input.buffer, input.byteOffset + 3, 20);
+	assert.strictEqual(heks.encode(view), Buffer.from(view).toString("hex"));
+	const words = new Uint32Array([0x11223344, 0xaabbccdd]);
+	assert.strictEqual(heks.encode(words), Buffer.from(words.buffer).toString("hex"));
+	assert.strictEqual(heks.encode(words.buffer), Buffer.from(words.buffer).toString("hex"));
+	assert.strictEqual(heks.encode(new DataView(input.buffer, input.byteOffset, 4)), input.toString("hex", 0, 4));
+}
 console.log("Encoding OK");
 
-const dest1 = new Uint8Array(a.length / 2);
-const dest2 = new Uint8Array(a.length / 2);
-const dest3 = new Uint8Array(a.length / 2);
+// decode / decodeInto from strings and Buffers, lower and mixed case
+for (const length of lengths) {
+	const input = pattern(length);
+	const lower = input.toString("hex");
+	const mixed = [...lower].map((c, i) => (i % 3 ? c : c.toUpperCase())).join("");
+
+	assert.deepStrictEqual(heks.decode(lower), input, `decode ${length}`);
+	assert.deepStrictEqual(heks.decode(mixed), input, `decode mixed ${length}`);
+	assert.deepStrictEqual(heks.decode(Buffer.from(lower, "latin1")), input, `decode Buffer ${length}`);
+
+	const dest = Buffer.alloc(length + 2, 0x2a);
+	assert.strictEqual(heks.decodeInto(mixed, dest), length);
+	assert.deepStrictEqual(dest.subarray(0, length), input);
+	assert.deepStrictEqual(dest.subarray(length), Buffer.from("**"), "decodeInto writes past the output");
+}
 
-pkg.decodeHexNode(dest1, a);
-pkg.decodeHexNode2(dest2, a);
-pkg.decodeHexVec(dest3, a);
-assert.deepStrictEqual(dest1, dest2);
-assert.deepStrictEqual(dest1, dest3);
+assert.throws(() => heks.decode("abc"), RangeError);
+assert.throws(() => heks.decode(42), TypeError);
+assert.throws(() => heks.encode("not bytes"), TypeError);
+assert.throws(() => heks.encodeInto(pattern(4), Buffer.alloc(7)), RangeError);
+assert.throws(() => heks.decodeInto("aabb", Buffer.alloc(1)), RangeError);
 console.log("Decoding OK");
+
+// Async: inline below the threshold, on the threadpool above it
+(async () => {
+	for (const threshold of [Infinity, 0]) {
+		heks.setAsyncThreshold(threshold);
+		for (const length of [0, 5, 64, 100000]) {
+			const input = pattern(length);
+			const hex = input.toString("hex");
+			assert.strictEqual(await heks.encodeAsync(input), hex);
+			assert.strictEqual(await heks.encodeAsync(input, true), hex.toUpperCase());
+			assert.deepStrictEqual(await heks.decodeAsync(hex), input);
+			assert.deepStrictEqual(await heks.decodeAsync(Buffer.from(hex, "latin1")), input);
+		}
+	}
+
+	// Many concurrent jobs
+	heks.setAsyncThreshold(1);
+	const inputs = Array.from({length: 64}, (_, i) => pattern(1000 + i));
+	const encoded = await Promise.all(inputs.map((input) => heks.encodeAsync(input)));
+	encoded.forEach((hex, i) => assert.strictEqual(hex, inputs[i].toString("hex")));
+	const decoded = await Promise.all(encoded.map((hex) => heks.decodeAsync(hex)));
+	decoded.forEach((buf, i) => assert.deepStrictEqual(buf, inputs[i]));
+
+	assert.throws(() => heks.decodeAsync("abc"), RangeError);
+	assert.strictEqual(heks.setAsyncThreshold(1 << 20), 1);
+	console.log("Async OK");
+
+	const workers = Array.from({length: 4}, () => new Worker(__filename));
+	await Promise.all(workers.map((worker) => new Promise((resolve, reject) => {
+		worker.on("message", resolve);
+		worker.on("error", reject);
+	})));
+	assert.strictEqual(heks.setAsyncThreshold(1 << 20), 1 << 20);
+	console.log("Workers OK");
+})().catch((err) => {
+	console.error(err);
+	process.exit(1);
+});
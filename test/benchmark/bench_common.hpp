@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <unistd.h>
+#endif
+
+// Shared helpers for the benchmark matrix: buffer pools, data generators and the memcpy baseline.
+namespace bench
+{
+
+// Shape of the generated input
+enum class Data : int64_t
+{
+    Patterned = 0, // i % 256 (binary) or its lower-case encoding (hex)
+    Random = 1, // uniformly random bytes (binary) or random mixed-case hex digits (hex)
+};
+
+// Where the buffers live when a kernel is called
+enum class Residency : int64_t
+{
+    Warm = 0, // a single buffer pair reused by every iteration
+    Cold = 1, // a pool of buffer pairs larger than the LLC, visited in random order
+};
+
+using clock = std::chrono::steady_clock;
+
+constexpr size_t cache_line = 64;
+constexpr size_t page_size = 4096;
+
+inline size_t round_up(size_t value, size_t to)
+{
+    return (value + to - 1) / to * to;
+}
+
+inline size_t llc_size()
+{
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    const long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc > 0)
+        return static_cast<size_t>(llc);
+#endif
+    return size_t{64} << 20;
+}
+
+struct FreeDeleter
+{
+    void operator()(uint8_t * p) const { std::free(p); }
+};
+using AlignedPtr = std::unique_ptr<uint8_t[], FreeDeleter>;
+
+// Page aligned, zeroed (i.e. faulted-in) allocation
+inline AlignedPtr allocate(size_t bytes)
+{
+    bytes = round_up(bytes == 0 ? 1 : bytes, page_size);
+    auto * p = static_cast<uint8_t *>(std::aligned_alloc(page_size, bytes));
+    std::memset(p, 0, bytes);
+    return AlignedPtr(p);
+}
+
+inline void fill_binary(uint8_t * dest, size_t size, Data data, std::mt19937_64 & rng)
+{
+    if (data == Data::Patterned)
+    {
+        for (size_t i = 0; i < size; ++i)
+            dest[i] = static_cast<uint8_t>(i % 256);
+        return;
+    }
+    for (size_t i = 0; i < size; ++i)
+        dest[i] = static_cast<uint8_t>(rng());
+}
+
+// size is the number of hex characters
+inline void fill_hex(uint8_t * dest, size_t size, Data data, std::mt19937_64 & rng)
+{
+    constexpr char lower[] = "0123456789abcdef";
+    constexpr char mixed[] = "0123456789abcdefABCDEF";
+    if (data == Data::Patterned)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto byte = (i / 2) % 256;
+            dest[i] = static_cast<uint8_t>(lower[i % 2 == 0 ? byte >> 4 : byte & 0xF]);
+        }
+        return;
+    }
+    for (size_t i = 0; i < size; ++i)
+        dest[i] = static_cast<uint8_t>(mixed[rng() % (sizeof(mixed) - 1)]);
+}
+
+// A set of (src, dst) buffer slots.
+// Warm: a single slot. Cold: enough slots to cover twice the LLC. Slots are a page plus a cache line
+// apart (so neighbours don't share lines or a prefetch stream) and are visited in a shuffled order.
+class Workload
+{
+public:
+    Workload(size_t src_bytes, size_t dst_bytes, size_t src_offset, size_t dst_offset, Residency residency)
+        : src_offset_(src_offset)
+        , dst_offset_(dst_offset)
+        , src_stride_(round_up(src_bytes + src_offset, page_size) + cache_line)
+        , dst_stride_(round_up(dst_bytes + dst_offset, page_size) + cache_line)
+    {
+        size_t slots = 1;
+        if (residency == Residency::Cold)
+            slots = std::max<size_t>(1, (2 * llc_size() + src_stride_ + dst_stride_ - 1) / (src_stride_ + dst_stride_));
+        src_pool_ = allocate(src_stride_ * slots);
+        dst_pool_ = allocate(dst_stride_ * slots);
+
+        order_.resize(slots);
+        std::iota(order_.begin(), order_.end(), size_t{0});
+        std::shuffle(order_.begin(), order_.end(), std::mt19937_64{42});
+    }
+
+    size_t slots() const { return order_.size(); }
+    uint8_t * src(size_t slot) const { return src_pool_.get() + slot * src_stride_ + src_offset_; }
+    uint8_t * dst(size_t slot) const { return dst_pool_.get() + slot * dst_stride_ + dst_offset_; }
+
+    // Fill every source slot using fill(dest, rng)
+    template <typename Fill>
+    void fill_sources(Fill fill) const
+    {
+        std::mt19937_64 rng{1234};
+        for (size_t slot = 0; slot < slots(); ++slot)
+            fill(src(slot), rng);
+    }
+
+    std::pair<const uint8_t *, uint8_t *> next()
+    {
+        const size_t slot = order_[position_];
+        if (++position_ == order_.size())
+            position_ = 0;
+        return {src(slot), dst(slot)};
+    }
+
+private:
+    size_t src_offset_;
+    size_t dst_offset_;
+    size_t src_stride_;
+    size_t dst_stride_;
+    AlignedPtr src_pool_;
+    AlignedPtr dst_pool_;
+    std::vector<size_t> order_;
+    size_t position_ = 0;
+};
+
+// Bytes per second achieved by memcpy over the same workload shape. Measured once per shape.
+inline double memcpy_rate(size_t size, size_t src_offset, size_t dst_offset, Residency residency)
+{
+    using Key = std::tuple<size_t, size_t, size_t, Residency>;
+    static std::map<Key, double> cache;
+    const Key key{size, src_offset, dst_offset, residency};
+    if (auto it = cache.find(key); it != cache.end())
+        return it->second;
+
+    Workload workload(size, size, src_offset, dst_offset, residency);
+    for (size_t slot = 0; slot < workload.slots(); ++slot)
+        std::memcpy(workload.dst(slot), workload.src(slot), size);
+
+    const auto min_time = std::chrono::milliseconds(100);
+    const size_t batch = size >= (size_t{64} << 10) ? 1 : 64;
+    size_t iterations = 0;
+    const auto start = clock::now();
+    auto elapsed = clock::duration{};
+    do
+    {
+        for (size_t i = 0; i < batch; ++i)
+        {
+            auto [src, dst] = workload.next();
+            std::memcpy(dst, src, size);
+            benchmark::DoNotOptimize(dst);
+            benchmark::ClobberMemory();
+        }
+        iterations += batch;
+        elapsed = clock::now() - start;
+    } while (elapsed < min_time);
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double rate = static_cast<double>(size) * static_cast<double>(iterations) / seconds;
+    cache.emplace(key, rate);
+    return rate;
+}
+
+// Arguments of every matrix benchmark: raw (binary) length, source and destination misalignment,
+// data distribution and cache residency.
+struct MatrixArgs
+{
+    size_t size;
+    size_t src_offset;
+    size_t dst_offset;
+    Data data;
+    Residency residency;
+
+    explicit MatrixArgs(const benchmark::State & state)
+        : size(static_cast<size_t>(state.range(0)))
+        , src_offset(static_cast<size_t>(state.range(1)))
+        , dst_offset(static_cast<size_t>(state.range(2)))
+        , data(static_cast<Data>(state.range(3)))
+        , residency(static_cast<Residency>(state.range(4)))
+    {
+    }
+};
+
+inline void matrix(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({"bytes", "src_off", "dst_off", "random", "cold"});
+    b->ArgsProduct({benchmark::CreateRange(1, int64_t{256} << 20, 8), {0, 1}, {0, 1}, {0, 1}, {0, 1}});
+}
+
+// Wall time of the benchmark loop, used for the memcpy_frac counter
+class LoopTimer
+{
+public:
+    LoopTimer()
+        : start_(clock::now())
+    {
+    }
+
+    double seconds() const { return std::chrono::duration<double>(clock::now() - start_).count(); }
+
+private:
+    clock::time_point start_;
+};
+
+// Throughput is reported in raw (binary) bytes, i.e. RawLength, for both directions.
+// memcpy_frac is the kernel throughput as a fraction of memcpy of RawLength bytes over the same workload.
+inline void report(benchmark::State & state, const MatrixArgs & args, const LoopTimer & timer)
+{
+    const double seconds = timer.seconds();
+    const auto bytes = static_cast<double>(state.iterations()) * static_cast<double>(args.size);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    if (seconds > 0)
+        state.counters["memcpy_frac"] = bytes / seconds / memcpy_rate(args.size, args.src_offset, args.dst_offset, args.residency);
+}
+
+} // namespace bench
@@ -2,13 +2,25 @@
 #ifdef FAST_HEX_STATIC_SHARED_LIBRARY
 #    include <fast_hex/fast_hex.hpp>
 #else
+#    include "fast_hex/fast_hex_base64.hpp"
+#    include "fast_hex/fast_hex_carray.hpp"
+#    include "fast_hex/fast_hex_compare.hpp"
+#    include "fast_hex/fast_hex_crc32c.hpp"
 #    include "fast_hex/fast_hex_inline.hpp"
+#    include "fast_hex/fast_hex_nibble.hpp"
+#    include "fast_hex/fast_hex_percent.hpp"
+#    include "fast_hex/fast_hex_records.hpp"
+#    include "fast_hex/fast_hex_scan.hpp"
 #endif
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <random>
+#include <regex>
+#include <string>
 #include <vector>
 
 #ifdef FAST_HEX_USE_NAMESPACE
@@ -82,6 +94,20 @@ std::vector<T> createInputData(size_t count, T)
     } \
     BENCHMARK(BM_##func_name##_##size_name);
 
+#define DEFINE_DECODE_BENCHMARK_FAST(func_name, size_val, size_name) \
+    static void BM_##func_name##_##size_name(benchmark::State & state) \
+    { \
+        auto hex = createHexData(size_val); \
+        std::vector<uint8_t> binary(size_val); \
+\
+        for (auto _ : state) \
+        { \
+            func_name(binary.data(), hex.data()); \
+            benchmark::DoNotOptimize(binary); \
+        } \
+    } \
+    BENCHMARK(BM_##func_name##_##size_name);
+
 #define DEFINE_DECODE_BENCHMARK(func_name, size_val, size_name) \
     static void BM_##func_name##_##size_name(benchmark::State & state) \
     { \
@@ -149,6 +175,54 @@ std::vector<T> createInputData(size_t count, T)
     } \
     BENCHMARK(BM_##func_name##_##size_name);
 
+#define DEFINE_ENCODE_WIDE_BENCHMARK(func_name, CharT, size_val, size_name) \
+    static void BM_##func_name##_##size_name(benchmark::State & state) \
+    { \
+        auto data = createBinaryData(size_val); \
+        std::vector<CharT> hex(size_val * 2); \
+\
+        for (auto _ : state) \
+        { \
+            func_name(hex.data(), data.data(), RawLength{size_val}); \
+            benchmark::DoNotOptimize(hex); \
+        } \
+    } \
+    BENCHMARK(BM_##func_name##_##size_name);
+
+// What the UTF-16/UTF-32 encoders replace: bytes into a scratch buffer, widened in a second loop
+template <auto Encode, typename CharT>
+void twoPassEncode(CharT * dest, const uint8_t * src, RawLength len)
+{
+    static std::vector<uint8_t> scratch;
+    scratch.resize(static_cast<size_t>(len) * 2);
+    Encode(scratch.data(), src, len);
+    std::copy(scratch.begin(), scratch.end(), dest);
+}
+
+void twoPassLower16(char16_t * dest, const uint8_t * src, RawLength len)
+{
+    twoPassEncode<encodeHexLower>(dest, src, len);
+}
+
+#if defined(FAST_HEX_AVX2)
+void twoPassLowerVec16(char16_t * dest, const uint8_t * src, RawLength len)
+{
+    twoPassEncode<encodeHexLowerVec>(dest, src, len);
+}
+
+void twoPassLowerVec32(char32_t * dest, const uint8_t * src, RawLength len)
+{
+    twoPassEncode<encodeHexLowerVec>(dest, src, len);
+}
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+void twoPassNeonLower16(char16_t * dest, const uint8_t * src, RawLength len)
+{
+    twoPassEncode<encodeHexNeonLower>(dest, src, len);
+}
+#endif // FAST_HEX_NEON
+
 // clang-format off
 
 // ---- Encoding Benchmarks ----
@@ -160,14 +234,32 @@ DEFINE_ENCODE_BENCHMARK(encodeHexLower, 64, 64B)
 DEFINE_ENCODE_BENCHMARK(encodeHexLower, 1024, 1KB)
 DEFINE_ENCODE_BENCHMARK(encodeHexLower, 1024 * 1024, 1MB)
 
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 8, 8B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 16, 16B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 32, 32B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 64, 64B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 1024, 1KB)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerSWAR, 1024 * 1024, 1MB)
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerGeneric, 16, 16B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerGeneric, 32, 32B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerGeneric, 64, 64B)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerGeneric, 1024, 1KB)
+DEFINE_ENCODE_BENCHMARK(encodeHexLowerGeneric, 1024 * 1024, 1MB)
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
 #if defined(FAST_HEX_AVX)
 DEFINE_ENCODE_BENCHMARK_FAST(encodeHex8LowerFast, 8, 8B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex8Fast, 8, 8B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex16Fast, 16, 16B)
 #endif
 
 #if defined(FAST_HEX_AVX2)
 DEFINE_ENCODE_BENCHMARK(encodeHexLowerVec, 8, 8B)
 DEFINE_ENCODE_BENCHMARK(encodeHexLowerVec, 16, 16B)
 DEFINE_ENCODE_BENCHMARK_FAST(encodeHex16LowerFast, 16, 16B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex32Fast, 32, 32B)
 DEFINE_ENCODE_BENCHMARK(encodeHexLowerVec, 32, 32B)
 DEFINE_ENCODE_BENCHMARK(encodeHexLowerVec, 64, 64B)
 DEFINE_ENCODE_BENCHMARK(encodeHexLowerVec, 1024, 1KB)
@@ -179,12 +271,42 @@ DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 8, 8B)
 DEFINE_ENCODE_BENCHMARK_FAST(encodeHex8LowerNeon, 8, 8B)
 DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 16, 16B)
 DEFINE_ENCODE_BENCHMARK_FAST(encodeHex16LowerNeon, 16, 16B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex8Neon, 8, 8B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex16Neon, 16, 16B)
+DEFINE_DECODE_BENCHMARK_FAST(decodeHex32Neon, 32, 32B)
 DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 32, 32B)
 DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 64, 64B)
 DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 1024, 1KB)
 DEFINE_ENCODE_BENCHMARK(encodeHexNeonLower, 1024 * 1024, 1MB)
 #endif // FAST_HEX_NEON
 
+// ---- UTF-16 / UTF-32 Encoding Benchmarks (one pass vs. two pass) ----
+
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLower16, char16_t, 64, 64B)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLower16, char16_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLower16, char16_t, 64, 64B)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLower16, char16_t, 1024, 1KB)
+
+#if defined(FAST_HEX_AVX2)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLowerVec16, char16_t, 64, 64B)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLowerVec16, char16_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLowerVec16, char16_t, 1024 * 1024, 1MB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLowerVec16, char16_t, 64, 64B)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLowerVec16, char16_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLowerVec16, char16_t, 1024 * 1024, 1MB)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLowerVec32, char32_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexLowerVec32, char32_t, 1024 * 1024, 1MB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLowerVec32, char32_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassLowerVec32, char32_t, 1024 * 1024, 1MB)
+#endif // defined(FAST_HEX_AVX2)
+
+#if defined(FAST_HEX_NEON)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexNeonLower16, char16_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(encodeHexNeonLower16, char16_t, 1024 * 1024, 1MB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassNeonLower16, char16_t, 1024, 1KB)
+DEFINE_ENCODE_WIDE_BENCHMARK(twoPassNeonLower16, char16_t, 1024 * 1024, 1MB)
+#endif // FAST_HEX_NEON
+
 // ---- Decoding Benchmarks ----
 
 DEFINE_DECODE_BENCHMARK(decodeHexLUT, 8, 8B)
@@ -208,6 +330,21 @@ DEFINE_DECODE_BENCHMARK(decodeHexBMI, 64, 64B)
 DEFINE_DECODE_BENCHMARK(decodeHexBMI, 1024, 1KB)
 DEFINE_DECODE_BENCHMARK(decodeHexBMI, 1024 * 1024, 1MB)
 
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 8, 8B)
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 16, 16B)
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 32, 32B)
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 64, 64B)
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 1024, 1KB)
+DEFINE_DECODE_BENCHMARK(decodeHexSWAR, 1024 * 1024, 1MB)
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+DEFINE_DECODE_BENCHMARK(decodeHexGeneric, 16, 16B)
+DEFINE_DECODE_BENCHMARK(decodeHexGeneric, 32, 32B)
+DEFINE_DECODE_BENCHMARK(decodeHexGeneric, 64, 64B)
+DEFINE_DECODE_BENCHMARK(decodeHexGeneric, 1024, 1KB)
+DEFINE_DECODE_BENCHMARK(decodeHexGeneric, 1024 * 1024, 1MB)
+#endif // defined(FAST_HEX_GENERIC_SIMD)
+
 #if defined(FAST_HEX_AVX2)
 DEFINE_DECODE_BENCHMARK(decodeHexVec, 8, 8B)
 DEFINE_DECODE_BENCHMARK(decodeHexVec, 16, 16B)
@@ -215,9 +352,574 @@ DEFINE_DECODE_BENCHMARK(decodeHexVec, 32, 32B)
 DEFINE_DECODE_BENCHMARK(decodeHexVec, 64, 64B)
 DEFINE_DECODE_BENCHMARK(decodeHexVec, 1024, 1KB)
 DEFINE_DECODE_BENCHMARK(decodeHexVec, 1024 * 1024, 1MB)
+DEFINE_DECODE_BENCHMARK(decodeHexVecMaddubs, 32, 32B)
+DEFINE_DECODE_BENCHMARK(decodeHexVecMaddubs, 64, 64B)
+DEFINE_DECODE_BENCHMARK(decodeHexVecMaddubs, 1024, 1KB)
+DEFINE_DECODE_BENCHMARK(decodeHexVecMaddubs, 1024 * 1024, 1MB)
 #endif // defined(FAST_HEX_AVX2)
 
 #ifndef FAST_HEX_STATIC_SHARED_LIBRARY
+// xxd -i style output, 12 items per line
+static void BM_encodeCArray(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto data = createBinaryData(size);
+    std::vector<uint8_t> out(c_array_size(RawLength{size}));
+    for (auto _ : state)
+    {
+        encodeCArray(out.data(), data.data(), RawLength{size}, lower);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_encodeCArray)->Arg(64)->Arg(1024)->Arg(1024 * 1024);
+
+// Two-pass baselines for the hex <-> base64 transcoders: decode_auto / encode_auto through a temporary
+// binary buffer, with the same base64 kernels for the other pass
+static void base64Encode(uint8_t * dest, const uint8_t * src, size_t size)
+{
+    size_t i = 0;
+#    if defined(FAST_HEX_AVX2)
+    for (; i + 32 <= size; i += 24)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i lanes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i / 3 * 4), heks_detail::base64EncodeVec(lanes));
+    }
+#    endif
+    for (; i + 3 <= size; i += 3)
+        heks_detail::base64Quantum(dest + i / 3 * 4, (uint32_t{src[i]} << 16) | (uint32_t{src[i + 1]} << 8) | src[i + 2]);
+}
+
+static void base64Decode(uint8_t * dest, const uint8_t * src, size_t length)
+{
+    size_t i = 0;
+#    if defined(FAST_HEX_AVX2)
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i bytes;
+        if (!heks_detail::base64DecodeVec(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)), bytes))
+            std::abort();
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(dest + i / 4 * 3), _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+    }
+#    endif
+    for (; i < length; i += 4)
+    {
+        const uint32_t group = (uint32_t{heks_detail::base64_values[src[i]]} << 18) | (uint32_t{heks_detail::base64_values[src[i + 1]]} << 12)
+            | (uint32_t{heks_detail::base64_values[src[i + 2]]} << 6) | heks_detail::base64_values[src[i + 3]];
+        dest[i / 4 * 3] = static_cast<uint8_t>(group >> 16);
+        dest[i / 4 * 3 + 1] = static_cast<uint8_t>(group >> 8);
+        dest[i / 4 * 3 + 2] = static_cast<uint8_t>(group);
+    }
+}
+
+// Args: raw bytes (a multiple of 3), two-pass (0/1)
+static void BM_hexToBase64(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto hex = createHexData(size);
+    std::vector<uint8_t> binary(size + 32);
+    std::vector<uint8_t> out(base64_size(RawLength{size}) + 32);
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+            hex_to_base64(out.data(), hex.data(), RawLength{size});
+        else
+        {
+            decode_auto(binary.data(), hex.data(), RawLength{size});
+            base64Encode(out.data(), binary.data(), size);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size * 2));
+}
+BENCHMARK(BM_hexToBase64)->ArgNames({"bytes", "two_pass"})->ArgsProduct({{63, 1023, 1024 * 1023}, {0, 1}});
+
+static void BM_base64ToHex(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto data = createBinaryData(size);
+    std::vector<uint8_t> base64(base64_size(RawLength{size}));
+    base64Encode(base64.data(), data.data(), size);
+    std::vector<uint8_t> binary(size + 32);
+    std::vector<uint8_t> out(size * 2);
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+        {
+            if (!base64_to_hex(out.data(), base64.data(), base64.size(), lower))
+                std::abort();
+        }
+        else
+        {
+            base64Decode(binary.data(), base64.data(), base64.size());
+            encode_auto(out.data(), binary.data(), RawLength{size}, lower);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(base64.size()));
+}
+BENCHMARK(BM_base64ToHex)->ArgNames({"bytes", "two_pass"})->ArgsProduct({{63, 1023, 1024 * 1023}, {0, 1}});
+
+// Args: raw bytes, two-pass (0/1: encode_auto / decode_auto, then crc32c over the binary side)
+static void BM_encodeHexCrc32c(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto data = createBinaryData(size);
+    std::vector<uint8_t> out(size * 2);
+    for (auto _ : state)
+    {
+        uint32_t crc;
+        if (state.range(1) == 0)
+            crc = encodeHexCrc32c(out.data(), data.data(), RawLength{size}, lower);
+        else
+        {
+            encode_auto(out.data(), data.data(), RawLength{size}, lower);
+            crc = crc32c(data.data(), size);
+        }
+        benchmark::DoNotOptimize(crc);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_encodeHexCrc32c)->ArgNames({"bytes", "two_pass"})->ArgsProduct({{4096, 64 * 1024, 1024 * 1024}, {0, 1}});
+
+static void BM_decodeHexCrc32c(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto hex = createHexData(size);
+    std::vector<uint8_t> out(size);
+    for (auto _ : state)
+    {
+        uint32_t crc;
+        if (state.range(1) == 0)
+            crc = decodeHexCrc32c(out.data(), hex.data(), RawLength{size});
+        else
+        {
+            decode_auto(out.data(), hex.data(), RawLength{size});
+            crc = crc32c(out.data(), size);
+        }
+        benchmark::DoNotOptimize(crc);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_decodeHexCrc32c)->ArgNames({"bytes", "two_pass"})->ArgsProduct({{4096, 64 * 1024, 1024 * 1024}, {0, 1}});
+
+// Args: raw bytes, mode (0: hex_equals, 1: decode_auto + memcmp, 2: memcmp of the binary data alone)
+static void BM_hexEquals(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto hex = createHexData(size);
+    std::vector<uint8_t> data(size);
+    decode_auto(data.data(), hex.data(), RawLength{size});
+    std::vector<uint8_t> binary(size);
+    std::vector<uint8_t> copy = data;
+    for (auto _ : state)
+    {
+        bool equal;
+        if (state.range(1) == 0)
+            equal = hex_equals(hex.data(), data.data(), RawLength{size});
+        else if (state.range(1) == 1)
+        {
+            decode_auto(binary.data(), hex.data(), RawLength{size});
+            equal = std::memcmp(binary.data(), data.data(), size) == 0;
+        }
+        else
+            equal = std::memcmp(copy.data(), data.data(), size) == 0;
+        benchmark::DoNotOptimize(equal);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_hexEquals)->ArgNames({"bytes", "mode"})->ArgsProduct({{32, 4096, 1024 * 1024}, {0, 1, 2}});
+
+// Service log lines with trace and span IDs, digests and addresses among timestamps, words and numbers
+static std::vector<uint8_t> createLogData(size_t size)
+{
+    std::mt19937 gen(42);
+    const auto hex = [&](size_t digits)
+    {
+        std::string out;
+        for (size_t i = 0; i < digits; ++i)
+            out += "0123456789abcdef"[gen() % 16];
+        return out;
+    };
+    const char * const levels[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    const char * const paths[] = {"/api/v1/items", "/api/v1/users/profile", "/healthz", "/static/app.js"};
+    std::string log;
+    while (log.size() < size)
+    {
+        log += "2024-05-01T12:" + std::to_string(10 + gen() % 50) + ":" + std::to_string(10 + gen() % 50) + "." + std::to_string(100 + gen() % 900)
+            + "Z " + levels[gen() % 4] + " request handled trace_id=" + hex(32) + " span_id=" + hex(16) + " path=" + paths[gen() % 4] + "/"
+            + std::to_string(gen() % 100000) + " status=200 latency_ms=" + std::to_string(gen() % 1000);
+        if (gen() % 4 == 0)
+            log += " sha256=" + hex(64);
+        if (gen() % 8 == 0)
+            log += " fault_addr=0x7ffe" + hex(8);
+        log += '\n';
+    }
+    log.resize(size);
+    return {log.begin(), log.end()};
+}
+
+// Runs of at least 16 hex digits. Args: text bytes, mode (0: find_hex_runs, 1: byte loop, 2: std::regex)
+static void BM_findHexRuns(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto text = createLogData(size);
+    const std::regex pattern("[0-9a-fA-F]{16,}");
+    for (auto _ : state)
+    {
+        size_t runs = 0;
+        if (state.range(1) == 0)
+            find_hex_runs(text.data(), size, 16, [&](HexRun) { ++runs; });
+        else if (state.range(1) == 1)
+        {
+            size_t length = 0;
+            for (size_t i = 0; i <= size; ++i)
+            {
+                if (i < size && heks_detail::isHexDigit(text[i]))
+                    ++length;
+                else
+                {
+                    runs += length >= 16;
+                    length = 0;
+                }
+            }
+        }
+        else
+        {
+            const auto * begin = reinterpret_cast<const char *>(text.data());
+            runs = static_cast<size_t>(std::distance(std::cregex_iterator(begin, begin + size, pattern), std::cregex_iterator()));
+        }
+        benchmark::DoNotOptimize(runs);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_findHexRuns)->ArgNames({"bytes", "mode"})->ArgsProduct({{4096, 1024 * 1024}, {0, 1, 2}});
+
+// Extraction with decoding of every run
+static void BM_decodeHexRuns(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto text = createLogData(size);
+    std::vector<uint8_t> dest((size + 1) / 2);
+    for (auto _ : state)
+    {
+        const size_t runs = decode_hex_runs(dest.data(), text.data(), size, 16, [](HexRun, const uint8_t *, size_t) {});
+        benchmark::DoNotOptimize(runs);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_decodeHexRuns)->Arg(4096)->Arg(1024 * 1024);
+
+// Query strings: parameter names and values, some of them with escaped spaces, reserved characters and UTF-8
+static std::vector<uint8_t> createQueryData(size_t size)
+{
+    std::mt19937 gen(42);
+    const char * const names[] = {"q", "page", "sort", "filter", "utm_source", "session_id", "lang"};
+    const char * const values[]
+        = {"running%20shoes", "2", "price%3Aasc", "caf%C3%A9%20cr%C3%A8me", "newsletter", "4bf92f3577b34da6", "en-US"};
+    std::string query;
+    while (query.size() < size)
+        query += std::string(names[gen() % 7]) + "=" + values[gen() % 7] + "&";
+    query.resize(size);
+    return {query.begin(), query.end()};
+}
+
+// Args: text bytes, mode (0: percent_decode, 1: memchr loop without SIMD, 2: byte loop)
+static void BM_percentDecode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto text = createQueryData(size);
+    std::vector<uint8_t> dest(size);
+    for (auto _ : state)
+    {
+        size_t written = 0;
+        if (state.range(1) == 0)
+            written = percent_decode(dest.data(), text.data(), size);
+        else if (state.range(1) == 1)
+            written = heks_detail::percentDecodeImpl(dest.data(), text.data(), size);
+        else
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (text[i] == '%' && i + 2 < size && heks_detail::isHexDigit(text[i + 1]) && heks_detail::isHexDigit(text[i + 2]))
+                {
+                    dest[written++] = static_cast<uint8_t>((heks_detail::unhexB(text[i + 1]) << 4) | heks_detail::unhexB(text[i + 2]));
+                    i += 2;
+                }
+                else
+                    dest[written++] = text[i];
+            }
+        }
+        benchmark::DoNotOptimize(written);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_percentDecode)->ArgNames({"bytes", "mode"})->ArgsProduct({{256, 64 * 1024}, {0, 1, 2}});
+
+// Args: text bytes, mode (0: percent_encode, 1: scalar percentEncodeImpl)
+static void BM_percentEncode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto text = createQueryData(size * 2);
+    text.resize(percent_decode(text.data(), text.data(), text.size()));
+    text.resize(size);
+    std::vector<uint8_t> dest(size * 3);
+    for (auto _ : state)
+    {
+        size_t written = 0;
+        if (state.range(1) == 0)
+            written = percent_encode(dest.data(), text.data(), size, percent_path);
+        else
+            written = heks_detail::percentEncodeImpl<heks_detail::HexCase::Upper>(dest.data(), text.data(), size, percent_path);
+        benchmark::DoNotOptimize(written);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_percentEncode)->ArgNames({"bytes", "mode"})->ArgsProduct({{256, 64 * 1024}, {0, 1}});
+
+// Intel HEX written a character at a time, with the checksum summed alongside: 16 bytes per record from
+// address 0, an extended linear address record every 64 KiB
+static size_t ihexEncodeBytewise(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    const char * digits = "0123456789ABCDEF";
+    uint8_t * out = dest;
+    uint8_t sum = 0;
+    auto put = [&](size_t value)
+    {
+        const auto byte = static_cast<uint8_t>(value);
+        *out++ = static_cast<uint8_t>(digits[byte >> 4]);
+        *out++ = static_cast<uint8_t>(digits[byte & 0xF]);
+        sum = static_cast<uint8_t>(sum + byte);
+    };
+    auto record = [&](size_t count, size_t offset, size_t type, const uint8_t * data)
+    {
+        *out++ = ':';
+        sum = 0;
+        put(count), put(offset >> 8), put(offset), put(type);
+        for (size_t k = 0; k < count; ++k)
+            put(data[k]);
+        put(0x100 - sum);
+        *out++ = '\n';
+    };
+    for (size_t address = 0; address < len; address += 16)
+    {
+        if (address != 0 && address % 0x10000 == 0)
+        {
+            const uint8_t base[2] = {static_cast<uint8_t>(address >> 24), static_cast<uint8_t>(address >> 16)};
+            record(2, 0, 4, base);
+        }
+        record(std::min<size_t>(16, len - address), address & 0xFFFF, 0, src + address);
+    }
+    record(0, 0, 1, nullptr);
+    return static_cast<size_t>(out - dest);
+}
+
+// The data records of Intel HEX from ihexEncodeBytewise, a character at a time; false on a bad checksum
+static bool ihexDecodeBytewise(uint8_t * dest, const uint8_t * text, size_t len)
+{
+    uint32_t base = 0;
+    for (size_t i = 0; i < len && text[i] == ':';)
+    {
+        auto get = [&](size_t at) { return static_cast<uint8_t>(heks_detail::unhexA(text[at]) | heks_detail::unhexB(text[at + 1])); };
+        const uint8_t count = get(i + 1);
+        const uint32_t offset = static_cast<uint32_t>(get(i + 3) << 8) | get(i + 5);
+        const uint8_t type = get(i + 7);
+        uint8_t sum = static_cast<uint8_t>(count + (offset >> 8) + offset + type);
+        for (size_t k = 0; k <= count; ++k)
+        {
+            const uint8_t byte = get(i + 9 + k * 2);
+            sum = static_cast<uint8_t>(sum + byte);
+            if (type == 0 && k < count)
+                dest[base + offset + k] = byte;
+        }
+        if (sum != 0)
+            return false;
+        if (type == 4)
+            base = static_cast<uint32_t>(get(i + 9) << 24) | static_cast<uint32_t>(get(i + 11) << 16);
+        i += 12 + count * 2u;
+    }
+    return true;
+}
+
+// Args: image bytes, mode (0: RecordEncoder, 1: a character at a time)
+static void BM_ihexEncode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = createBinaryData(size);
+    std::vector<uint8_t> dest(ihex_encoded_size(size));
+    for (auto _ : state)
+    {
+        const size_t written = state.range(1) == 0 ? ihex_encode(dest.data(), data.data(), size) : ihexEncodeBytewise(dest.data(), data.data(), size);
+        benchmark::DoNotOptimize(written);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_ihexEncode)->ArgNames({"bytes", "mode"})->ArgsProduct({{4 << 20}, {0, 1}});
+
+// Args: image bytes, mode (0: RecordDecoder, 1: a character at a time)
+static void BM_ihexDecode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = createBinaryData(size);
+    std::vector<uint8_t> text(ihex_encoded_size(size));
+    text.resize(ihex_encode(text.data(), data.data(), size));
+    std::vector<uint8_t> dest(size);
+    for (auto _ : state)
+    {
+        bool ok = true;
+        if (state.range(1) == 0)
+            ok = !ihex_decode(
+                text.data(), text.size(), [&](uint32_t address, const uint8_t * bytes, size_t n) { std::memcpy(dest.data() + address, bytes, n); });
+        else
+            ok = ihexDecodeBytewise(dest.data(), text.data(), text.size());
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_ihexDecode)->ArgNames({"bytes", "mode"})->ArgsProduct({{4 << 20}, {0, 1}});
+
+// Arg: image bytes
+static void BM_srecEncode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = createBinaryData(size);
+    std::vector<uint8_t> dest(srec_encoded_size(size));
+    for (auto _ : state)
+    {
+        const size_t written = srec_encode(dest.data(), data.data(), size);
+        benchmark::DoNotOptimize(written);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_srecEncode)->ArgName("bytes")->Arg(4 << 20);
+
+// Arg: image bytes
+static void BM_srecDecode(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = createBinaryData(size);
+    std::vector<uint8_t> text(srec_encoded_size(size));
+    text.resize(srec_encode(text.data(), data.data(), size));
+    std::vector<uint8_t> dest(size);
+    for (auto _ : state)
+    {
+        const auto ec = srec_decode(
+            text.data(), text.size(), [&](uint32_t address, const uint8_t * bytes, size_t n) { std::memcpy(dest.data() + address, bytes, n); });
+        benchmark::DoNotOptimize(ec);
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_srecDecode)->ArgName("bytes")->Arg(4 << 20);
+
+// Args: digits (odd), mode (0: decode_padded, 1: copy behind a '0' into a padded buffer, then decode_auto)
+static void BM_decodePadded(benchmark::State & state)
+{
+    const auto len = static_cast<size_t>(state.range(0));
+    const auto text = createHexData(len / 2 + 1);
+    std::vector<uint8_t> padded(len + 1);
+    std::vector<uint8_t> dest(len / 2 + 1);
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+            decode_padded(dest.data(), text.data(), NibbleLength{len}, NibblePad::Left);
+        else
+        {
+            padded[0] = '0';
+            std::memcpy(padded.data() + 1, text.data(), len);
+            decode_auto(dest.data(), padded.data(), RawLength{len / 2 + 1});
+        }
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(len));
+}
+BENCHMARK(BM_decodePadded)->ArgNames({"digits", "mode"})->ArgsProduct({{19, 63, 65535}, {0, 1}});
+
+// Args: digits, mode (0: encode_nibbles from nibble 1, 1: shift the bytes a nibble left into a buffer, then encode_auto)
+static void BM_encodeNibbles(benchmark::State & state)
+{
+    const auto len = static_cast<size_t>(state.range(0));
+    const auto data = createBinaryData(len / 2 + 1);
+    std::vector<uint8_t> shifted(len / 2 + 1);
+    std::vector<uint8_t> dest(len + 2);
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+            encode_nibbles(dest.data(), data.data(), NibbleLength{len}, 1);
+        else
+        {
+            for (size_t i = 0; i < len / 2; ++i)
+                shifted[i] = static_cast<uint8_t>((data[i] << 4) | (data[i + 1] >> 4));
+            encode_auto(dest.data(), shifted.data(), RawLength{len / 2}, upper);
+        }
+        benchmark::DoNotOptimize(dest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(len));
+}
+BENCHMARK(BM_encodeNibbles)->ArgNames({"digits", "mode"})->ArgsProduct({{64, 4096, 65536}, {0, 1}});
+
+// Arg: runtime (0/1: encode<N> / encode_auto with a length the compiler cannot see)
+template <size_t N>
+static void BM_encodeFixed(benchmark::State & state)
+{
+    auto data = createBinaryData(N);
+    // Larger than needed: GCC otherwise warns about the vector loop of the runtime path it cannot rule out
+    std::vector<uint8_t> out(1024);
+    size_t size = N;
+    benchmark::DoNotOptimize(size);
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+            encode<N, lower_t>(out.data(), data.data());
+        else
+            encode_auto(out.data(), data.data(), RawLength{size}, lower);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(N));
+}
+BENCHMARK_TEMPLATE(BM_encodeFixed, 4)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_encodeFixed, 12)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_encodeFixed, 20)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_encodeFixed, 32)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_encodeFixed, 64)->ArgName("runtime")->Arg(0)->Arg(1);
+
+// Arg: runtime (0/1: decode<N> / decode_auto with a length the compiler cannot see)
+template <size_t N>
+static void BM_decodeFixed(benchmark::State & state)
+{
+    auto hex = createHexData(N);
+    std::vector<uint8_t> out(1024);
+    size_t size = N;
+    benchmark::DoNotOptimize(size);
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+            decode<N>(out.data(), hex.data());
+        else
+            decode_auto(out.data(), hex.data(), RawLength{size});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(N));
+}
+BENCHMARK_TEMPLATE(BM_decodeFixed, 4)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_decodeFixed, 12)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_decodeFixed, 20)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_decodeFixed, 32)->ArgName("runtime")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_decodeFixed, 64)->ArgName("runtime")->Arg(0)->Arg(1);
+
 DEFINE_ENCODE_INTEGRAL_BENCHMARK(encode_integral_naive, uint64_t, 1, 1_uint64)
 DEFINE_ENCODE_INTEGRAL_BENCHMARK(encode_integral_naive, uint64_t, 8, 8_uint64)
 DEFINE_ENCODE_INTEGRAL_BENCHMARK(encode_integral_naive, uint64_t, 1024, 1024_uint64)
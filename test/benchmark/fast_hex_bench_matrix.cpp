@@ -0,0 +1,105 @@
+#include <fast_hex/fast_hex.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+#ifdef FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+// Benchmark matrix: every kernel over sizes 1B-256MB, source/destination misalignment,
+// patterned/random data and warm/cold buffers. See bench_common.hpp for the dimensions.
+// The full matrix is large; use --benchmark_filter to select e.g. a kernel or 'cold:1'.
+
+using Kernel = void (*)(uint8_t *, const uint8_t *, RawLength);
+
+static void BM_memcpy(benchmark::State & state)
+{
+    const bench::MatrixArgs args(state);
+    bench::Workload workload(args.size, args.size, args.src_offset, args.dst_offset, args.residency);
+    workload.fill_sources([&](uint8_t * dest, auto & rng) { bench::fill_binary(dest, args.size, args.data, rng); });
+
+    const bench::LoopTimer timer;
+    for (auto _ : state)
+    {
+        auto [src, dst] = workload.next();
+        std::memcpy(dst, src, args.size);
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, args, timer);
+}
+
+static void BM_encode(benchmark::State & state, Kernel kernel)
+{
+    const bench::MatrixArgs args(state);
+    bench::Workload workload(args.size, args.size * 2, args.src_offset, args.dst_offset, args.residency);
+    workload.fill_sources([&](uint8_t * dest, auto & rng) { bench::fill_binary(dest, args.size, args.data, rng); });
+
+    const bench::LoopTimer timer;
+    for (auto _ : state)
+    {
+        auto [src, dst] = workload.next();
+        kernel(dst, src, RawLength{args.size});
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, args, timer);
+}
+
+static void BM_decode(benchmark::State & state, Kernel kernel)
+{
+    const bench::MatrixArgs args(state);
+    bench::Workload workload(args.size * 2, args.size, args.src_offset, args.dst_offset, args.residency);
+    workload.fill_sources([&](uint8_t * dest, auto & rng) { bench::fill_hex(dest, args.size * 2, args.data, rng); });
+
+    const bench::LoopTimer timer;
+    for (auto _ : state)
+    {
+        auto [src, dst] = workload.next();
+        kernel(dst, src, RawLength{args.size});
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, args, timer);
+}
+
+// clang-format off
+
+BENCHMARK(BM_memcpy)->Apply(bench::matrix);
+
+// ---- Encoding ----
+
+BENCHMARK_CAPTURE(BM_encode, encodeHexLower, encodeHexLower)->Apply(bench::matrix);
+BENCHMARK_CAPTURE(BM_encode, encodeHexLowerSWAR, encodeHexLowerSWAR)->Apply(bench::matrix);
+#if defined(FAST_HEX_GENERIC_SIMD)
+BENCHMARK_CAPTURE(BM_encode, encodeHexLowerGeneric, encodeHexLowerGeneric)->Apply(bench::matrix);
+#endif
+#if defined(FAST_HEX_AVX2)
+BENCHMARK_CAPTURE(BM_encode, encodeHexLowerVec, encodeHexLowerVec)->Apply(bench::matrix);
+#endif
+#if defined(FAST_HEX_NEON)
+BENCHMARK_CAPTURE(BM_encode, encodeHexNeonLower, encodeHexNeonLower)->Apply(bench::matrix);
+#endif
+
+// ---- Decoding ----
+
+BENCHMARK_CAPTURE(BM_decode, decodeHexLUT, decodeHexLUT)->Apply(bench::matrix);
+BENCHMARK_CAPTURE(BM_decode, decodeHexLUT4, decodeHexLUT4)->Apply(bench::matrix);
+BENCHMARK_CAPTURE(BM_decode, decodeHexBMI, decodeHexBMI)->Apply(bench::matrix);
+BENCHMARK_CAPTURE(BM_decode, decodeHexSWAR, decodeHexSWAR)->Apply(bench::matrix);
+#if defined(FAST_HEX_GENERIC_SIMD)
+BENCHMARK_CAPTURE(BM_decode, decodeHexGeneric, decodeHexGeneric)->Apply(bench::matrix);
+#endif
+#if defined(FAST_HEX_AVX2)
+BENCHMARK_CAPTURE(BM_decode, decodeHexVec, decodeHexVec)->Apply(bench::matrix);
+BENCHMARK_CAPTURE(BM_decode, decodeHexVecMaddubs, decodeHexVecMaddubs)->Apply(bench::matrix);
+#endif
+
+BENCHMARK_MAIN();
+
+// clang-format on
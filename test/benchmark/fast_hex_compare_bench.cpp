@@ -0,0 +1,431 @@
+#include "fast_hex/fast_hex_format.hpp"
+#include "fast_hex/fast_hex_inline.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if __has_include(<format>)
+#    include <format>
+#endif
+#if defined(FAST_HEX_BENCH_HAVE_FMT)
+#    include <fmt/format.h>
+#endif
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+#ifdef FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+// Compares heks with commonly used alternatives over the size/data/residency matrix from bench_common.hpp
+// and prints a consolidated GB/s table at the end of the run.
+// All alternatives are reimplemented here the way they are typically used; outputs are checked against heks.
+
+namespace
+{
+
+// ---- snprintf / sscanf ----
+
+void encode_snprintf(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    char buf[3];
+    for (size_t i = 0; i < len; ++i)
+    {
+        std::snprintf(buf, sizeof(buf), "%02x", src[i]);
+        std::memcpy(dest + i * 2, buf, 2);
+    }
+}
+
+void decode_sscanf(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    char buf[3] = {};
+    for (size_t i = 0; i < len; ++i)
+    {
+        std::memcpy(buf, src + i * 2, 2);
+        unsigned int value = 0;
+        std::sscanf(buf, "%2x", &value);
+        dest[i] = static_cast<uint8_t>(value);
+    }
+}
+
+// ---- std::format / fmt ----
+
+#if defined(__cpp_lib_format)
+void encode_std_format(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    auto * out = reinterpret_cast<char *>(dest);
+    for (size_t i = 0; i < len; ++i)
+        out = std::format_to(out, "{:02x}", src[i]);
+}
+
+// heks::hex_view formatter (fast_hex_format.hpp)
+void encode_std_format_hex_view(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    std::format_to(reinterpret_cast<char *>(dest), "{}", hex_view(src, len));
+}
+#endif
+
+#if defined(FAST_HEX_BENCH_HAVE_FMT)
+void encode_fmt(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    auto * out = reinterpret_cast<char *>(dest);
+    for (size_t i = 0; i < len; ++i)
+        out = fmt::format_to(out, "{:02x}", src[i]);
+}
+
+void encode_fmt_hex_view(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    fmt::format_to(reinterpret_cast<char *>(dest), "{}", hex_view(src, len));
+}
+#endif
+
+// ---- std::to_chars / std::from_chars ----
+
+void encode_to_chars(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    auto * out = reinterpret_cast<char *>(dest);
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (src[i] < 0x10)
+        {
+            out[0] = '0';
+            std::to_chars(out + 1, out + 2, src[i], 16);
+        }
+        else
+        {
+            std::to_chars(out, out + 2, src[i], 16);
+        }
+        out += 2;
+    }
+}
+
+void decode_from_chars(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    const auto * in = reinterpret_cast<const char *>(src);
+    for (size_t i = 0; i < len; ++i)
+    {
+        std::from_chars(in, in + 2, dest[i], 16);
+        in += 2;
+    }
+}
+
+// ---- Boost.Algorithm style hex_lower / unhex (iterator based, throws on bad input) ----
+
+struct non_hex_input : std::invalid_argument
+{
+    non_hex_input()
+        : std::invalid_argument("non-hex input")
+    {
+    }
+};
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator boost_hex_lower(InputIterator first, InputIterator last, OutputIterator out)
+{
+    constexpr char digits[] = "0123456789abcdef";
+    for (; first != last; ++first)
+    {
+        const auto value = static_cast<uint8_t>(*first);
+        char res[2];
+        char * p = res + 2;
+        auto v = value;
+        for (size_t i = 0; i < 2; ++i, v = static_cast<uint8_t>(v >> 4))
+            *--p = digits[v & 0x0F];
+        out = std::copy(res, res + 2, out);
+    }
+    return out;
+}
+
+inline uint8_t boost_hex_char_to_int(char c)
+{
+    if (c >= '0' && c <= '9')
+        return static_cast<uint8_t>(c - '0');
+    if (c >= 'A' && c <= 'F')
+        return static_cast<uint8_t>(c - 'A' + 10);
+    if (c >= 'a' && c <= 'f')
+        return static_cast<uint8_t>(c - 'a' + 10);
+    throw non_hex_input();
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator boost_unhex(InputIterator first, InputIterator last, OutputIterator out)
+{
+    while (first != last)
+    {
+        uint8_t res = 0;
+        for (size_t i = 0; i < 2; ++i)
+        {
+            if (first == last)
+                throw std::invalid_argument("not enough input");
+            res = static_cast<uint8_t>((res << 4) + boost_hex_char_to_int(static_cast<char>(*first++)));
+        }
+        *out++ = res;
+    }
+    return out;
+}
+
+void encode_boost_style(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    boost_hex_lower(src, src + len, dest);
+}
+
+void decode_boost_style(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    boost_unhex(src, src + len * 2, dest);
+}
+
+// ---- Classic 256-entry table scalar loops ----
+
+struct Tables
+{
+    uint16_t encode[256];
+    uint8_t decode[256];
+
+    Tables()
+    {
+        constexpr char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < 256; ++i)
+        {
+            const char pair[2] = {digits[i >> 4], digits[i & 0xF]};
+            std::memcpy(&encode[i], pair, 2);
+            decode[i] = 0xFF;
+        }
+        for (uint8_t i = 0; i < 10; ++i)
+            decode['0' + i] = i;
+        for (uint8_t i = 0; i < 6; ++i)
+        {
+            decode['a' + i] = static_cast<uint8_t>(10 + i);
+            decode['A' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+};
+const Tables tables;
+
+void encode_table(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        std::memcpy(dest + i * 2, &tables.encode[src[i]], 2);
+}
+
+void decode_table(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        dest[i] = static_cast<uint8_t>((tables.decode[src[i * 2]] << 4) | tables.decode[src[i * 2 + 1]]);
+}
+
+// ---- heks ----
+
+void encode_heks_scalar(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    encodeHexLower(dest, src, RawLength{len});
+}
+
+void encode_heks_auto(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    encode_auto(dest, src, RawLength{len}, lower);
+}
+
+void decode_heks_scalar(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    decodeHexLUT4(dest, src, RawLength{len});
+}
+
+void decode_heks_auto(uint8_t * dest, const uint8_t * src, size_t len)
+{
+    decode_auto(dest, src, RawLength{len});
+}
+
+using Impl = void (*)(uint8_t *, const uint8_t *, size_t);
+
+// Checks an alternative against heks on a small mixed input
+bool matches_heks(Impl impl, bool encode)
+{
+    constexpr size_t len = 1000;
+    std::vector<uint8_t> raw(len);
+    std::vector<uint8_t> hex(len * 2);
+    std::mt19937_64 rng{7};
+    bench::fill_binary(raw.data(), len, bench::Data::Random, rng);
+    encodeHexLower(hex.data(), raw.data(), RawLength{len});
+
+    if (encode)
+    {
+        std::vector<uint8_t> out(len * 2);
+        impl(out.data(), raw.data(), len);
+        return out == hex;
+    }
+    bench::fill_hex(hex.data(), len * 2, bench::Data::Random, rng);
+    std::vector<uint8_t> expected(len);
+    std::vector<uint8_t> out(len);
+    decodeHexLUT(expected.data(), hex.data(), RawLength{len});
+    impl(out.data(), hex.data(), len);
+    return out == expected;
+}
+
+void BM_encode(benchmark::State & state, Impl impl)
+{
+    if (!matches_heks(impl, true))
+    {
+        state.SkipWithError("output differs from heks");
+        return;
+    }
+    const bench::MatrixArgs args(state);
+    bench::Workload workload(args.size, args.size * 2, args.src_offset, args.dst_offset, args.residency);
+    workload.fill_sources([&](uint8_t * dest, auto & rng) { bench::fill_binary(dest, args.size, args.data, rng); });
+
+    const bench::LoopTimer timer;
+    for (auto _ : state)
+    {
+        auto [src, dst] = workload.next();
+        impl(dst, src, args.size);
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, args, timer);
+}
+
+void BM_decode(benchmark::State & state, Impl impl)
+{
+    if (!matches_heks(impl, false))
+    {
+        state.SkipWithError("output differs from heks");
+        return;
+    }
+    const bench::MatrixArgs args(state);
+    bench::Workload workload(args.size * 2, args.size, args.src_offset, args.dst_offset, args.residency);
+    workload.fill_sources([&](uint8_t * dest, auto & rng) { bench::fill_hex(dest, args.size * 2, args.data, rng); });
+
+    const bench::LoopTimer timer;
+    for (auto _ : state)
+    {
+        auto [src, dst] = workload.next();
+        impl(dst, src, args.size);
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    bench::report(state, args, timer);
+}
+
+// Same dimensions as bench::matrix, without the misalignment axes
+void compare_matrix(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({"bytes", "src_off", "dst_off", "random", "cold"});
+    b->ArgsProduct({benchmark::CreateRange(1, int64_t{256} << 20, 8), {0}, {0}, {0, 1}, {0, 1}});
+}
+
+// Console output as usual, followed by one table per direction: a row per matrix point, a GB/s column per implementation.
+class ConsolidatedReporter : public benchmark::ConsoleReporter
+{
+public:
+    void ReportRuns(const std::vector<Run> & reports) override
+    {
+        ConsoleReporter::ReportRuns(reports);
+        for (const auto & run : reports)
+        {
+            const auto bytes_per_second = run.counters.find("bytes_per_second");
+            if (run.run_type != Run::RT_Iteration || bytes_per_second == run.counters.end())
+                continue;
+            // function_name is "BM_<direction>/<implementation>"
+            const auto & function = run.run_name.function_name;
+            const auto slash = function.find('/');
+            const auto direction = function.substr(3, slash - 3);
+            const auto impl = function.substr(slash + 1);
+            auto & table = tables_[direction];
+            if (std::find(table.columns.begin(), table.columns.end(), impl) == table.columns.end())
+                table.columns.push_back(impl);
+            if (table.values.find(run.run_name.args) == table.values.end())
+                table.rows.push_back(run.run_name.args);
+            table.values[run.run_name.args][impl] = bytes_per_second->second.value / 1e9;
+        }
+    }
+
+    void Finalize() override
+    {
+        auto & out = GetOutputStream();
+        for (const auto & [direction, table] : tables_)
+        {
+            out << "\n" << direction << " (GB/s)\n" << std::setw(50) << std::left << "args";
+            for (const auto & impl : table.columns)
+                out << std::setw(16) << std::right << impl;
+            out << "\n";
+            for (const auto & args : table.rows)
+            {
+                const auto & values = table.values.at(args);
+                out << std::setw(50) << std::left << args;
+                for (const auto & impl : table.columns)
+                {
+                    const auto it = values.find(impl);
+                    out << std::setw(16) << std::right;
+                    if (it == values.end())
+                        out << "-";
+                    else
+                        out << std::fixed << std::setprecision(3) << it->second;
+                }
+                out << "\n";
+            }
+        }
+        ConsoleReporter::Finalize();
+    }
+
+private:
+    struct Table
+    {
+        std::vector<std::string> columns; // implementations, in registration order
+        std::vector<std::string> rows; // matrix points, in run order
+        std::map<std::string, std::map<std::string, double>> values;
+    };
+    std::map<std::string, Table> tables_;
+};
+
+} // namespace
+
+// clang-format off
+
+// ---- Encoding ----
+
+BENCHMARK_CAPTURE(BM_encode, snprintf, encode_snprintf)->Apply(compare_matrix);
+#if defined(__cpp_lib_format)
+BENCHMARK_CAPTURE(BM_encode, std_format, encode_std_format)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, std_format_hex_view, encode_std_format_hex_view)->Apply(compare_matrix);
+#endif
+#if defined(FAST_HEX_BENCH_HAVE_FMT)
+BENCHMARK_CAPTURE(BM_encode, fmt, encode_fmt)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, fmt_hex_view, encode_fmt_hex_view)->Apply(compare_matrix);
+#endif
+BENCHMARK_CAPTURE(BM_encode, to_chars, encode_to_chars)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, boost_style, encode_boost_style)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, table256, encode_table)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, heks_scalar, encode_heks_scalar)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_encode, heks_auto, encode_heks_auto)->Apply(compare_matrix);
+
+// ---- Decoding ----
+
+BENCHMARK_CAPTURE(BM_decode, sscanf, decode_sscanf)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_decode, from_chars, decode_from_chars)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_decode, boost_style, decode_boost_style)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_decode, table256, decode_table)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_decode, heks_scalar, decode_heks_scalar)->Apply(compare_matrix);
+BENCHMARK_CAPTURE(BM_decode, heks_auto, decode_heks_auto)->Apply(compare_matrix);
+
+// clang-format on
+
+int main(int argc, char ** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    ConsolidatedReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
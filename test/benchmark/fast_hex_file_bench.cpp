@@ -0,0 +1,256 @@
+#include <fast_hex/fast_hex_file.hpp>
+#include <fast_hex/fast_hex_pipeline.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#ifdef FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+// encode_file/decode_file (mmap) against a read() -> kernel -> write() loop over 4 MiB heap buffers,
+// with the input in the page cache (hot) or evicted before every iteration (cold). Files live in
+// $TMPDIR; eviction uses POSIX_FADV_DONTNEED, which drops the clean pages without root.
+//   fast_hex_file_bench --benchmark_filter='encode/.*/cold:1'
+//
+// BM_stream does the same between pipes (fed from and drained to memory by two threads, like sockets),
+// where mmap is not possible: a serial read -> encode -> write loop against heks::Pipeline.
+
+namespace
+{
+
+constexpr size_t buffer_size = size_t{4} << 20;
+
+std::string bench_path(const char * name)
+{
+    return (std::filesystem::temp_directory_path() / (std::string("heks_file_bench_") + name)).string();
+}
+
+// Input files, created once per size and kind
+const std::string & input_file(size_t size, bool hex)
+{
+    static std::vector<std::pair<std::pair<size_t, bool>, std::string>> files;
+    for (const auto & [key, path] : files)
+        if (key == std::make_pair(size, hex))
+            return path;
+
+    std::vector<uint8_t> binary(size);
+    std::mt19937_64 rng(size);
+    for (auto & b : binary)
+        b = static_cast<uint8_t>(rng());
+    std::vector<uint8_t> data = binary;
+    if (hex)
+    {
+        data.resize(size * 2);
+        encodeHexLower(data.data(), binary.data(), RawLength{size});
+    }
+    const std::string path = bench_path((std::to_string(size >> 20) + (hex ? ".hex" : ".bin")).c_str());
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ::write(fd, data.data(), data.size()) != static_cast<ssize_t>(data.size()) || ::fsync(fd) != 0)
+        std::perror(path.c_str());
+    ::close(fd);
+    files.push_back({{size, hex}, path});
+    return files.back().second;
+}
+
+void evict(const std::string & path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+void warm(const std::string & path)
+{
+    std::vector<char> buffer(buffer_size);
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    while (::read(fd, buffer.data(), buffer.size()) > 0)
+    {
+    }
+    ::close(fd);
+}
+
+using Method = void (*)(const std::string & in, const std::string & out);
+
+void encode_mmap(const std::string & in, const std::string & out)
+{
+    if (encode_file(in.c_str(), out.c_str(), lower))
+        std::abort();
+}
+
+void decode_mmap(const std::string & in, const std::string & out)
+{
+    if (decode_file(in.c_str(), out.c_str()))
+        std::abort();
+}
+
+template <size_t InRatio, size_t OutRatio, typename Kernel>
+void read_write(const std::string & in, const std::string & out, Kernel kernel)
+{
+    static std::vector<uint8_t> src(buffer_size * InRatio);
+    static std::vector<uint8_t> dest(buffer_size * OutRatio);
+    const int in_fd = ::open(in.c_str(), O_RDONLY);
+    const int out_fd = ::open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    for (;;)
+    {
+        const ssize_t got = ::read(in_fd, src.data(), src.size());
+        if (got <= 0)
+            break;
+        const size_t raw = static_cast<size_t>(got) / InRatio;
+        kernel(dest.data(), src.data(), RawLength{raw});
+        if (::write(out_fd, dest.data(), raw * OutRatio) < 0)
+            std::abort();
+    }
+    ::close(in_fd);
+    ::close(out_fd);
+}
+
+void encode_read_write(const std::string & in, const std::string & out)
+{
+#if defined(FAST_HEX_AVX2)
+    read_write<1, 2>(in, out, encodeHexLowerVec);
+#else
+    read_write<1, 2>(in, out, encodeHexLower);
+#endif
+}
+
+void decode_read_write(const std::string & in, const std::string & out)
+{
+#if defined(FAST_HEX_AVX2)
+    read_write<2, 1>(in, out, decodeHexVec);
+#else
+    read_write<2, 1>(in, out, decodeHexLUT4);
+#endif
+}
+
+// Args: size in MiB, cold (0/1)
+void BM_file(benchmark::State & state, Method method, bool decode)
+{
+    const auto size = static_cast<size_t>(state.range(0)) << 20;
+    const bool cold = state.range(1) != 0;
+    const std::string & in = input_file(size, decode);
+    const std::string out = bench_path(decode ? "out.bin" : "out.hex");
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::filesystem::remove(out);
+        if (cold)
+            evict(in);
+        else
+            warm(in);
+        state.ResumeTiming();
+        method(in, out);
+    }
+    std::filesystem::remove(out);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+// Pipe fed from memory by one thread and drained by another around method(in_fd, out_fd)
+template <typename F>
+void stream(const std::vector<uint8_t> & data, F method)
+{
+    int in[2];
+    int out[2];
+    if (::pipe(in) != 0 || ::pipe(out) != 0)
+        std::abort();
+    std::thread feeder(
+        [&]
+        {
+            static_cast<void>(heks_detail::write_full(in[1], data.data(), data.size()));
+            ::close(in[1]);
+        });
+    std::thread drain(
+        [&]
+        {
+            std::vector<uint8_t> buffer(buffer_size);
+            while (::read(out[0], buffer.data(), buffer.size()) > 0)
+            {
+            }
+        });
+    method(in[0], out[1]);
+    ::close(out[1]);
+    feeder.join();
+    drain.join();
+    ::close(in[0]);
+    ::close(out[0]);
+}
+
+void stream_serial(int in_fd, int out_fd)
+{
+    static std::vector<uint8_t> src(buffer_size);
+    static std::vector<uint8_t> dest(buffer_size * 2);
+    for (;;)
+    {
+        size_t got = 0;
+        if (heks_detail::read_full(in_fd, src.data(), src.size(), got) || got == 0)
+            break;
+        encode_auto(dest.data(), src.data(), RawLength{got}, lower);
+        if (heks_detail::write_full(out_fd, dest.data(), got * 2))
+            std::abort();
+        if (got < src.size())
+            break;
+    }
+}
+
+// Args: size in MiB, method (0: serial, 1: Pipeline threads, 2: Pipeline io_uring)
+void BM_stream(benchmark::State & state)
+{
+    const auto size = static_cast<size_t>(state.range(0)) << 20;
+    std::vector<uint8_t> data(size);
+    std::mt19937_64 rng(size);
+    for (auto & b : data)
+        b = static_cast<uint8_t>(rng());
+
+    const auto method = state.range(1);
+    Pipeline pipeline({.chunk_size = buffer_size, .backend = method == 2 ? PipelineBackend::IoUring : PipelineBackend::Threads});
+    if (method == 2 && pipeline.backend() != PipelineBackend::IoUring)
+    {
+        state.SkipWithError("io_uring not available");
+        return;
+    }
+    for (auto _ : state)
+    {
+        if (method == 0)
+            stream(data, stream_serial);
+        else
+            stream(data, [&](int in_fd, int out_fd) { static_cast<void>(pipeline.encode(in_fd, out_fd, lower)); });
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+} // namespace
+
+// clang-format off
+
+#define FILE_ARGS ArgNames({"MiB", "cold"})->ArgsProduct({{64, 512}, {0, 1}})->UseRealTime()->Unit(benchmark::kMillisecond)
+
+BENCHMARK_CAPTURE(BM_file, encode/mmap, encode_mmap, false)->FILE_ARGS;
+BENCHMARK_CAPTURE(BM_file, encode/read_write, encode_read_write, false)->FILE_ARGS;
+BENCHMARK_CAPTURE(BM_file, decode/mmap, decode_mmap, true)->FILE_ARGS;
+BENCHMARK_CAPTURE(BM_file, decode/read_write, decode_read_write, true)->FILE_ARGS;
+
+BENCHMARK(BM_stream)->ArgNames({"MiB", "method"})->ArgsProduct({{256}, {0, 1, 2}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// clang-format on
+
+int main(int argc, char ** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    for (const char * name : {"64.bin", "64.hex", "512.bin", "512.hex"})
+        std::filesystem::remove(bench_path(name));
+    return 0;
+}
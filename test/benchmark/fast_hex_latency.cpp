@@ -0,0 +1,399 @@
+#include "fast_hex/fast_hex_inline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <x86intrin.h>
+#    endif
+#    define FAST_HEX_LATENCY_TSC 1
+#else
+#    include <atomic>
+#    include <time.h>
+#endif
+
+#ifdef FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+// Per-call latency distribution of the small fixed-size kernels.
+// Every call is timed on its own (serialised rdtsc/rdtscp on x86, clock_gettime elsewhere) and the
+// p50/p99/p99.9/max are reported for three modes:
+//   b2b   - calls back to back
+//   spin  - a scalar busy loop of --gap-us between calls (core stays awake, AVX units may power down)
+//   sleep - the thread sleeps --gap-us between calls (frequency/C-state transitions, cache first touch)
+// Pin the process (e.g. taskset -c 2) for stable numbers.
+
+namespace
+{
+
+template <typename T>
+inline void escape(T & value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+
+#if defined(FAST_HEX_LATENCY_TSC)
+// lfence; rdtsc; lfence ... rdtscp; lfence keeps the measured call between the two reads
+inline uint64_t start_ticks()
+{
+    _mm_lfence();
+    const uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+inline uint64_t stop_ticks()
+{
+    unsigned int aux;
+    const uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+
+double calibrate_ns_per_tick()
+{
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    const uint64_t c0 = start_ticks();
+    while (clock::now() - t0 < std::chrono::milliseconds(100))
+    {
+    }
+    const uint64_t c1 = stop_ticks();
+    const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+    return elapsed / static_cast<double>(c1 - c0);
+}
+#else
+inline uint64_t now_ns()
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+inline uint64_t start_ticks()
+{
+    return now_ns();
+}
+
+inline uint64_t stop_ticks()
+{
+    return now_ns();
+}
+
+double calibrate_ns_per_tick()
+{
+    return 1.0;
+}
+#endif
+
+enum class Mode
+{
+    BackToBack,
+    Spin,
+    Sleep,
+};
+
+constexpr std::string_view mode_name(Mode mode)
+{
+    switch (mode)
+    {
+        case Mode::BackToBack:
+            return "b2b";
+        case Mode::Spin:
+            return "spin";
+        case Mode::Sleep:
+            return "sleep";
+    }
+    return "?";
+}
+
+struct Options
+{
+    size_t samples = 20000;
+    size_t idle_samples = 2000;
+    std::chrono::microseconds gap{1000};
+    std::string filter;
+};
+
+void spin_for(std::chrono::microseconds gap)
+{
+    using clock = std::chrono::steady_clock;
+    const auto until = clock::now() + gap;
+    volatile uint64_t counter = 0;
+    while (clock::now() < until)
+        counter = counter + 1;
+}
+
+class Harness
+{
+public:
+    explicit Harness(Options options)
+        : options_(std::move(options))
+        , ns_per_tick_(calibrate_ns_per_tick())
+    {
+        // Cost of an empty measurement, subtracted from every sample
+        std::vector<uint64_t> empty(10000);
+        for (auto & sample : empty)
+        {
+            const uint64_t t0 = start_ticks();
+            const uint64_t t1 = stop_ticks();
+            sample = t1 - t0;
+        }
+        std::sort(empty.begin(), empty.end());
+        overhead_ = empty[empty.size() / 2];
+        std::printf(
+            "# timer: %s, %.3f ns/tick, overhead %.1f ns (subtracted), gap %lld us\n",
+#if defined(FAST_HEX_LATENCY_TSC)
+            "rdtsc/rdtscp",
+#else
+            "clock_gettime",
+#endif
+            ns_per_tick_,
+            static_cast<double>(overhead_) * ns_per_tick_,
+            static_cast<long long>(options_.gap.count()));
+        std::printf("%-28s %6s %6s %10s %10s %10s %10s\n", "kernel", "bytes", "mode", "p50_ns", "p99_ns", "p99.9_ns", "max_ns");
+    }
+
+    // f() performs one call of the kernel
+    template <typename F>
+    void run(std::string_view name, size_t bytes, F f)
+    {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string_view::npos)
+            return;
+        for (auto mode : {Mode::BackToBack, Mode::Spin, Mode::Sleep})
+        {
+            const size_t count = mode == Mode::BackToBack ? options_.samples : options_.idle_samples;
+            std::vector<uint64_t> samples(count);
+            // Warm up code and data before the first recorded call
+            for (size_t i = 0; i < 100; ++i)
+                f();
+            for (auto & sample : samples)
+            {
+                if (mode == Mode::Spin)
+                    spin_for(options_.gap);
+                else if (mode == Mode::Sleep)
+                    std::this_thread::sleep_for(options_.gap);
+                const uint64_t t0 = start_ticks();
+                f();
+                const uint64_t t1 = stop_ticks();
+                const uint64_t ticks = t1 - t0;
+                sample = ticks > overhead_ ? ticks - overhead_ : 0;
+            }
+            report(name, bytes, mode, samples);
+        }
+    }
+
+private:
+    void report(std::string_view name, size_t bytes, Mode mode, std::vector<uint64_t> & samples) const
+    {
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p)
+        {
+            const auto index = std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())));
+            return static_cast<double>(samples[index]) * ns_per_tick_;
+        };
+        std::printf(
+            "%-28.*s %6zu %6.*s %10.1f %10.1f %10.1f %10.1f\n",
+            static_cast<int>(name.size()),
+            name.data(),
+            bytes,
+            static_cast<int>(mode_name(mode).size()),
+            mode_name(mode).data(),
+            percentile(0.5),
+            percentile(0.99),
+            percentile(0.999),
+            static_cast<double>(samples.back()) * ns_per_tick_);
+    }
+
+    Options options_;
+    double ns_per_tick_;
+    uint64_t overhead_ = 0;
+};
+
+Options parse(int argc, char ** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        auto value = [&]() -> const char *
+        {
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "missing value for %s\n", argv[i]);
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--samples")
+            options.samples = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--idle-samples")
+            options.idle_samples = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--gap-us")
+            options.gap = std::chrono::microseconds(std::strtoll(value(), nullptr, 10));
+        else if (arg == "--filter")
+            options.filter = value();
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--samples N] [--idle-samples N] [--gap-us N] [--filter SUBSTRING]\n", argv[0]);
+            std::exit(arg == "--help" ? 0 : 1);
+        }
+    }
+    options.samples = std::max<size_t>(options.samples, 1);
+    options.idle_samples = std::max<size_t>(options.idle_samples, 1);
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Harness harness(parse(argc, argv));
+
+    alignas(64) uint8_t binary[64];
+    alignas(64) uint8_t hex[128];
+    alignas(64) uint8_t out[128];
+    for (size_t i = 0; i < sizeof(binary); ++i)
+        binary[i] = static_cast<uint8_t>(i * 37 + 11);
+    encodeHexLower(hex, binary, RawLength{sizeof(binary)});
+
+    auto encode = [&](auto kernel, size_t n)
+    {
+        return [&, kernel, n]
+        {
+            kernel(out, binary, RawLength{n});
+            escape(out);
+        };
+    };
+    auto decode = [&](auto kernel, size_t n)
+    {
+        return [&, kernel, n]
+        {
+            kernel(out, hex, RawLength{n});
+            escape(out);
+        };
+    };
+#if defined(FAST_HEX_AVX) || defined(FAST_HEX_NEON)
+    auto decode_fast = [&](auto kernel)
+    {
+        return [&, kernel]
+        {
+            kernel(out, hex);
+            escape(out);
+        };
+    };
+#endif
+
+    // ---- Encoding ----
+
+#if defined(FAST_HEX_AVX)
+    harness.run(
+        "encodeHex8LowerFast",
+        8,
+        [&]
+        {
+            encodeHex8LowerFast(out, binary);
+            escape(out);
+        });
+#endif
+#if defined(FAST_HEX_AVX2)
+    harness.run(
+        "encodeHex16LowerFast",
+        16,
+        [&]
+        {
+            encodeHex16LowerFast(out, binary);
+            escape(out);
+        });
+#endif
+#if defined(FAST_HEX_NEON)
+    harness.run(
+        "encodeHex8LowerNeon",
+        8,
+        [&]
+        {
+            encodeHex8LowerNeon(out, binary);
+            escape(out);
+        });
+    harness.run(
+        "encodeHex16LowerNeon",
+        16,
+        [&]
+        {
+            encodeHex16LowerNeon(out, binary);
+            escape(out);
+        });
+#endif
+    for (size_t n : {size_t{8}, size_t{16}, size_t{32}})
+    {
+        harness.run("encodeHexLower", n, encode(encodeHexLower, n));
+        harness.run("encodeHexLowerSWAR", n, encode(encodeHexLowerSWAR, n));
+#if defined(FAST_HEX_AVX2)
+        harness.run("encodeHexLowerVec", n, encode(encodeHexLowerVec, n));
+#endif
+#if defined(FAST_HEX_NEON)
+        harness.run("encodeHexNeonLower", n, encode(encodeHexNeonLower, n));
+#endif
+    }
+
+    // ---- Decoding ----
+
+#if defined(FAST_HEX_AVX)
+    harness.run(
+        "decode_integral8",
+        8,
+        [&]
+        {
+            uint64_t value = decode_integral8(hex);
+            escape(value);
+        });
+    harness.run("decodeHex8Fast", 8, decode_fast(decodeHex8Fast));
+    harness.run("decodeHex16Fast", 16, decode_fast(decodeHex16Fast));
+#endif
+#if defined(FAST_HEX_AVX2)
+    harness.run("decodeHex32Fast", 32, decode_fast(decodeHex32Fast));
+#endif
+#if defined(FAST_HEX_NEON)
+    harness.run("decodeHex8Neon", 8, decode_fast(decodeHex8Neon));
+    harness.run("decodeHex16Neon", 16, decode_fast(decodeHex16Neon));
+    harness.run("decodeHex32Neon", 32, decode_fast(decodeHex32Neon));
+#endif
+    harness.run(
+        "decode_integral_naive<u64>",
+        8,
+        [&]
+        {
+            uint64_t value = decode_integral_naive<uint64_t>(hex);
+            escape(value);
+        });
+    for (size_t n : {size_t{8}, size_t{16}, size_t{32}})
+    {
+        harness.run("decodeHexLUT4", n, decode(decodeHexLUT4, n));
+        harness.run("decodeHexBMI", n, decode(decodeHexBMI, n));
+        harness.run("decodeHexSWAR", n, decode(decodeHexSWAR, n));
+#if defined(FAST_HEX_AVX2)
+        harness.run("decodeHexVec", n, decode(decodeHexVec, n));
+        harness.run("decodeHexVecMaddubs", n, decode(decodeHexVecMaddubs, n));
+#endif
+    }
+    return 0;
+}
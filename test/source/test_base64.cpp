@@ -0,0 +1,173 @@
+#include "fast_hex/fast_hex_base64.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using HexToBase64 = size_t (*)(uint8_t *, const uint8_t *, RawLength);
+using Base64ToHex = bool (*)(uint8_t *, const uint8_t *, size_t);
+
+std::string reference_base64(const std::vector<uint8_t> & data)
+{
+    constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string text;
+    for (size_t i = 0; i < data.size(); i += 3)
+    {
+        const size_t n = std::min<size_t>(3, data.size() - i);
+        uint32_t group = uint32_t{data[i]} << 16;
+        if (n > 1)
+            group |= uint32_t{data[i + 1]} << 8;
+        if (n > 2)
+            group |= data[i + 2];
+        for (size_t k = 0; k < 4; ++k)
+            text += k <= n ? alphabet[(group >> (18 - 6 * k)) & 0x3F] : '=';
+    }
+    return text;
+}
+
+std::string hex_of(const std::vector<uint8_t> & data, bool upper_case)
+{
+    std::string hex(data.size() * 2, '\0');
+    if (upper_case)
+        encodeHexUpper(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    else
+        encodeHexLower(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    return hex;
+}
+
+std::vector<uint8_t> sample(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i * 89 + 7);
+    return data;
+}
+
+std::string to_base64(HexToBase64 kernel, std::string_view hex)
+{
+    const RawLength len{hex.size() / 2};
+    std::string out(base64_size(len) + 1, '#');
+    const size_t written = kernel(reinterpret_cast<uint8_t *>(out.data()), reinterpret_cast<const uint8_t *>(hex.data()), len);
+    REQUIRE(written == base64_size(len));
+    // Nothing written past the end
+    REQUIRE(out.back() == '#');
+    out.pop_back();
+    return out;
+}
+
+bool to_hex(Base64ToHex kernel, std::string_view base64, std::string & hex)
+{
+    const auto * src = reinterpret_cast<const uint8_t *>(base64.data());
+    hex.assign(static_cast<size_t>(base64_raw_length(src, base64.size())) * 2 + 1, '#');
+    const bool ok = kernel(reinterpret_cast<uint8_t *>(hex.data()), src, base64.size());
+    if (ok)
+        REQUIRE(hex.back() == '#');
+    hex.pop_back();
+    return ok;
+}
+
+void check_hex_to_base64(HexToBase64 kernel)
+{
+    // RFC 4648 test vectors
+    CHECK(to_base64(kernel, "") == "");
+    CHECK(to_base64(kernel, "66") == "Zg==");
+    CHECK(to_base64(kernel, "666f") == "Zm8=");
+    CHECK(to_base64(kernel, "666F6F") == "Zm9v");
+    CHECK(to_base64(kernel, "666f6f62") == "Zm9vYg==");
+    CHECK(to_base64(kernel, "666f6f6261") == "Zm9vYmE=");
+    CHECK(to_base64(kernel, "666f6f626172") == "Zm9vYmFy");
+
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        REQUIRE(to_base64(kernel, hex_of(data, false)) == reference_base64(data));
+        REQUIRE(to_base64(kernel, hex_of(data, true)) == reference_base64(data));
+    }
+}
+
+template <class Case>
+void check_base64_to_hex(Base64ToHex kernel)
+{
+    const bool upper_case = Case::value == heks_detail::HexCase::Upper;
+    std::string hex;
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        REQUIRE(to_hex(kernel, reference_base64(data), hex));
+        REQUIRE(hex == hex_of(data, upper_case));
+    }
+
+    // Every byte value in the vector part and in the final quantum
+    const std::string valid = reference_base64(sample(60));
+    for (int c = 0; c < 256; ++c)
+    {
+        CAPTURE(c);
+        const bool in_alphabet = std::isalnum(c) != 0 || c == '+' || c == '/';
+        for (size_t position : {5u, 31u, 70u, 78u})
+        {
+            std::string text = valid;
+            text[position] = static_cast<char>(c);
+            REQUIRE(to_hex(kernel, text, hex) == in_alphabet);
+        }
+    }
+
+    CHECK_FALSE(to_hex(kernel, "Zm9", hex));
+    CHECK_FALSE(to_hex(kernel, "Zg==Zm9v", hex));
+    CHECK_FALSE(to_hex(kernel, "Z===", hex));
+    CHECK_FALSE(to_hex(kernel, "Zm=v", hex));
+    CHECK(to_hex(kernel, "Zm8=", hex));
+    CHECK(hex == (upper_case ? "666F" : "666f"));
+}
+
+} // namespace
+
+TEST_CASE("hex_to_base64 scalar")
+{
+    check_hex_to_base64(heks_detail::hexToBase64Impl);
+}
+
+TEST_CASE("base64_to_hex scalar")
+{
+    check_base64_to_hex<lower_t>(heks_detail::base64ToHexImpl<heks_detail::HexCase::Lower>);
+    check_base64_to_hex<upper_t>(heks_detail::base64ToHexImpl<heks_detail::HexCase::Upper>);
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("hex_to_base64 AVX2")
+{
+    check_hex_to_base64(heks_detail::hexToBase64VecImpl);
+}
+
+TEST_CASE("base64_to_hex AVX2")
+{
+    check_base64_to_hex<lower_t>(heks_detail::base64ToHexVecImpl<heks_detail::HexCase::Lower>);
+    check_base64_to_hex<upper_t>(heks_detail::base64ToHexVecImpl<heks_detail::HexCase::Upper>);
+}
+#endif
+
+TEST_CASE("hex_to_base64 / base64_to_hex")
+{
+    const auto data = sample(1000);
+    const std::string hex = hex_of(data, false);
+    std::string base64(base64_size(RawLength{data.size()}), '\0');
+    hex_to_base64(reinterpret_cast<uint8_t *>(base64.data()), reinterpret_cast<const uint8_t *>(hex.data()), RawLength{data.size()});
+    REQUIRE(base64 == reference_base64(data));
+
+    std::string back(hex.size(), '\0');
+    REQUIRE(base64_to_hex(reinterpret_cast<uint8_t *>(back.data()), reinterpret_cast<const uint8_t *>(base64.data()), base64.size(), lower));
+    REQUIRE(back == hex);
+}
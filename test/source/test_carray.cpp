@@ -0,0 +1,91 @@
+#include "fast_hex/fast_hex_carray.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+std::string reference(const std::vector<uint8_t> & data, const CArrayOptions & options, bool upper_case)
+{
+    const size_t columns = options.columns == 0 ? data.size() : options.columns;
+    const char * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string text;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        if (i % columns == 0)
+            text += "  ";
+        text += options.upper_prefix ? "0X" : "0x";
+        text += digits[data[i] >> 4];
+        text += digits[data[i] & 0xF];
+        text += i + 1 == data.size() ? "\n" : (i + 1) % columns == 0 ? ",\n" : ", ";
+    }
+    return text;
+}
+
+template <class Case, template <heks_detail::HexCase> class Items>
+void check(const std::vector<uint8_t> & data, const CArrayOptions & options)
+{
+    const size_t size = c_array_size(RawLength{data.size()}, options);
+    std::vector<uint8_t> out(size + 1, '#');
+    const size_t written = heks_detail::encodeCArrayImpl<Case::value, Items<Case::value>>(out.data(), data.data(), RawLength{data.size()}, options);
+    REQUIRE(written == size);
+    REQUIRE(out[size] == '#');
+    REQUIRE(std::string(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(size)) == reference(data, options, Case::value == upper_t::value));
+}
+
+template <template <heks_detail::HexCase> class Items>
+void testCArray()
+{
+    for (const size_t length : {0u, 1u, 2u, 11u, 12u, 13u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 48u, 49u, 100u, 257u})
+    {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i)
+            data[i] = static_cast<uint8_t>(i * 37 + 5);
+        for (const size_t columns : {0u, 1u, 4u, 12u, 15u, 16u, 17u, 33u, 64u})
+        {
+            CAPTURE(length);
+            CAPTURE(columns);
+            check<lower_t, Items>(data, {.columns = columns});
+            check<upper_t, Items>(data, {.columns = columns, .upper_prefix = true});
+            check<upper_t, Items>(data, {.columns = columns, .upper_prefix = false});
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("encodeCArray scalar")
+{
+    testCArray<heks_detail::CArrayItems>();
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("encodeCArray AVX2")
+{
+    testCArray<heks_detail::CArrayItemsVec>();
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("encodeCArray NEON")
+{
+    testCArray<heks_detail::CArrayItemsNeon>();
+}
+#endif
+
+TEST_CASE("encodeCArray")
+{
+    const uint8_t data[] = {0x89, 0x50, 0x4e, 0x47};
+    char out[32] = {};
+    const size_t written = encodeCArray(reinterpret_cast<uint8_t *>(out), data, RawLength{sizeof(data)}, lower, {.columns = 3});
+    CHECK(std::string(out, written) == "  0x89, 0x50, 0x4e,\n  0x47\n");
+    CHECK(c_array_size(RawLength{0}) == 0);
+}
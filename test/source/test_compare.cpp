@@ -0,0 +1,144 @@
+#include "fast_hex/fast_hex_compare.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using CompareHex = int (*)(const uint8_t *, const uint8_t *, RawLength);
+
+std::vector<uint8_t> sample(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i * 89 + 7);
+    return data;
+}
+
+std::string hex_of(const std::vector<uint8_t> & data, bool upper_case)
+{
+    std::string hex(data.size() * 2, '\0');
+    if (upper_case)
+        encodeHexUpper(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    else
+        encodeHexLower(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    return hex;
+}
+
+int compare(CompareHex kernel, const std::string & hex, const std::vector<uint8_t> & data)
+{
+    return kernel(reinterpret_cast<const uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+}
+
+int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+void check_compare(CompareHex kernel)
+{
+    for (size_t size = 0; size <= 100; ++size)
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        std::string mixed = hex_of(data, false);
+        for (size_t p = 0; p < mixed.size(); p += 3)
+            mixed[p] = static_cast<char>(std::toupper(mixed[p]));
+        REQUIRE(compare(kernel, hex_of(data, false), data) == 0);
+        REQUIRE(compare(kernel, hex_of(data, true), data) == 0);
+        REQUIRE(compare(kernel, mixed, data) == 0);
+
+        // One byte changed, in every position: the order is that of the bytes
+        for (size_t i = 0; i < size; ++i)
+        {
+            CAPTURE(i);
+            for (int delta : {1, 16, 128})
+            {
+                auto other = data;
+                other[i] = static_cast<uint8_t>(other[i] + delta);
+                const int expected = sign(std::memcmp(data.data(), other.data(), size));
+                REQUIRE(compare(kernel, hex_of(data, false), other) == expected);
+                REQUIRE(compare(kernel, hex_of(data, true), other) == expected);
+            }
+        }
+    }
+
+    // Every character in every digit position of a block: only hex digits of the right value match
+    const auto data = sample(70);
+    const std::string valid = hex_of(data, false);
+    for (size_t position : {0u, 1u, 17u, 63u, 64u, 100u, 139u})
+    {
+        CAPTURE(position);
+        for (int c = 0; c < 256; ++c)
+        {
+            CAPTURE(c);
+            std::string text = valid;
+            text[position] = static_cast<char>(c);
+            const int result = compare(kernel, text, data);
+            if (std::isxdigit(c) == 0)
+                REQUIRE(result == heks_detail::compare_invalid);
+            else if (std::tolower(c) == valid[position])
+                REQUIRE(result == 0);
+            else
+                REQUIRE(result == (std::tolower(c) < valid[position] ? -1 : 1));
+        }
+    }
+
+    // Only the characters up to the first difference are looked at
+    std::string text = valid;
+    text[10] = valid[10] == '0' ? '1' : '0';
+    text[20] = 'x';
+    CHECK(compare(kernel, text, data) == (text[10] < valid[10] ? -1 : 1));
+    text[5] = 'x';
+    CHECK(compare(kernel, text, data) == heks_detail::compare_invalid);
+}
+
+} // namespace
+
+TEST_CASE("compare hex scalar")
+{
+    check_compare(heks_detail::compareHexImpl);
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("compare hex AVX2")
+{
+    check_compare(heks_detail::compareHexVecImpl);
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("compare hex NEON")
+{
+    check_compare(heks_detail::compareHexNeonImpl);
+}
+#endif
+
+TEST_CASE("hex_equals / hex_compare")
+{
+    const auto digest = sample(32);
+    const std::string etag = hex_of(digest, true);
+    const auto * hex = reinterpret_cast<const uint8_t *>(etag.data());
+    CHECK(hex_equals(hex, digest.data(), RawLength{32}));
+    CHECK(hex_compare(hex, digest.data(), RawLength{32}) == 0);
+
+    auto greater = digest;
+    greater[31]++;
+    CHECK_FALSE(hex_equals(hex, greater.data(), RawLength{32}));
+    CHECK(hex_compare(hex, greater.data(), RawLength{32}) < 0);
+
+    std::string bad = etag;
+    bad[0] = 'g';
+    CHECK_FALSE(hex_equals(reinterpret_cast<const uint8_t *>(bad.data()), digest.data(), RawLength{32}));
+    CHECK_FALSE(hex_compare(reinterpret_cast<const uint8_t *>(bad.data()), digest.data(), RawLength{32}).has_value());
+}
@@ -0,0 +1,167 @@
+#include "fast_hex/fast_hex_crc32c.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using EncodeCrc = uint32_t (*)(uint8_t *, const uint8_t *, RawLength, uint32_t);
+using DecodeCrc = uint32_t (*)(uint8_t *, const uint8_t *, RawLength, uint32_t);
+
+// Bit at a time, straight from the definition
+uint32_t reference_crc32c(const uint8_t * data, size_t size, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0x82F63B78 : 0);
+    }
+    return ~crc;
+}
+
+std::vector<uint8_t> sample(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i * 89 + 7);
+    return data;
+}
+
+std::string hex_of(const std::vector<uint8_t> & data, bool upper_case)
+{
+    std::string hex(data.size() * 2, '\0');
+    if (upper_case)
+        encodeHexUpper(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    else
+        encodeHexLower(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{data.size()});
+    return hex;
+}
+
+// The kernels work on the inverted checksum, as the public functions pass it
+void check_encode(EncodeCrc kernel, bool upper_case)
+{
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        std::string hex(size * 2 + 1, '#');
+        const uint32_t crc = ~kernel(reinterpret_cast<uint8_t *>(hex.data()), data.data(), RawLength{size}, ~uint32_t{0});
+        REQUIRE(hex.back() == '#');
+        hex.pop_back();
+        REQUIRE(hex == hex_of(data, upper_case));
+        REQUIRE(crc == reference_crc32c(data.data(), size));
+    }
+}
+
+void check_decode(DecodeCrc kernel)
+{
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        for (bool upper_case : {false, true})
+        {
+            const std::string hex = hex_of(data, upper_case);
+            std::vector<uint8_t> out(size + 1, 0xA5);
+            const uint32_t crc = ~kernel(out.data(), reinterpret_cast<const uint8_t *>(hex.data()), RawLength{size}, ~uint32_t{0});
+            REQUIRE(out.back() == 0xA5);
+            out.pop_back();
+            REQUIRE(out == data);
+            REQUIRE(crc == reference_crc32c(data.data(), size));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("crc32c")
+{
+    constexpr std::string_view check = "123456789";
+    const auto * digits = reinterpret_cast<const uint8_t *>(check.data());
+    CHECK(crc32c(digits, check.size()) == 0xE3069283);
+    CHECK(crc32c(digits, 0) == 0);
+
+    const auto data = sample(1000);
+    for (size_t size : {1u, 7u, 8u, 9u, 63u, 64u, 999u, 1000u})
+    {
+        CAPTURE(size);
+        CHECK(crc32c(data.data(), size) == reference_crc32c(data.data(), size));
+    }
+
+    // Continuing from the checksum of a prefix
+    const uint32_t head = crc32c(data.data(), 333);
+    CHECK(crc32c(data.data() + 333, 667, head) == crc32c(data.data(), 1000));
+}
+
+TEST_CASE("crc32c table fallback")
+{
+    const auto data = sample(64);
+    uint32_t words = ~uint32_t{0};
+    uint32_t bytes = ~uint32_t{0};
+    for (size_t i = 0; i < data.size(); i += 8)
+        words = heks_detail::crc32cWordTable(words, heks_detail::loadLE64(data.data() + i));
+    for (uint8_t byte : data)
+        bytes = heks_detail::crc32cByteTable(bytes, byte);
+    CHECK(~words == reference_crc32c(data.data(), data.size()));
+    CHECK(~bytes == reference_crc32c(data.data(), data.size()));
+}
+
+TEST_CASE("encodeHexCrc32c scalar")
+{
+    check_encode(heks_detail::encodeHexCrc32cImpl<heks_detail::HexCase::Lower>, false);
+    check_encode(heks_detail::encodeHexCrc32cImpl<heks_detail::HexCase::Upper>, true);
+}
+
+TEST_CASE("decodeHexCrc32c scalar")
+{
+    check_decode(heks_detail::decodeHexCrc32cImpl);
+}
+
+#if defined(FAST_HEX_AVX2) && defined(__SSE4_2__)
+TEST_CASE("encodeHexCrc32c AVX2")
+{
+    check_encode(heks_detail::encodeHexCrc32cVecImpl<heks_detail::HexCase::Lower>, false);
+    check_encode(heks_detail::encodeHexCrc32cVecImpl<heks_detail::HexCase::Upper>, true);
+}
+
+TEST_CASE("decodeHexCrc32c AVX2")
+{
+    check_decode(heks_detail::decodeHexCrc32cVecImpl);
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("encodeHexCrc32c NEON")
+{
+    check_encode(heks_detail::encodeHexCrc32cNeonImpl<heks_detail::HexCase::Lower>, false);
+    check_encode(heks_detail::encodeHexCrc32cNeonImpl<heks_detail::HexCase::Upper>, true);
+}
+#endif
+
+TEST_CASE("encodeHexCrc32c / decodeHexCrc32c")
+{
+    const auto data = sample(1000);
+    std::string hex(data.size() * 2, '\0');
+    auto * text = reinterpret_cast<uint8_t *>(hex.data());
+
+    // Record in two pieces, the second continuing the checksum of the first
+    const uint32_t head = encodeHexCrc32c(text, data.data(), RawLength{400}, upper);
+    const uint32_t crc = encodeHexCrc32c(text + 800, data.data() + 400, RawLength{600}, upper, head);
+    CHECK(hex == hex_of(data, true));
+    CHECK(crc == crc32c(data.data(), data.size()));
+
+    std::vector<uint8_t> back(data.size());
+    CHECK(decodeHexCrc32c(back.data(), text, RawLength{data.size()}) == crc);
+    CHECK(back == data);
+}
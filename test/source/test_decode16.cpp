@@ -0,0 +1,84 @@
+#ifdef FAST_HEX_STATIC_SHARED_LIBRARY
+#    include <fast_hex/fast_hex.hpp>
+#else
+#    include "fast_hex/fast_hex_inline.hpp"
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+using Decoder16 = bool (*)(uint8_t *, const char16_t *, RawLength);
+
+// Round trips through upper/lower/mixed case UTF-16 and flags code units above 0xFF at every position
+static void testHexDecoding16(Decoder16 decode)
+{
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        CAPTURE(length);
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i)
+            data[i] = static_cast<uint8_t>(i * 59 + 7);
+        std::vector<uint8_t> hex(length * 2);
+        encodeHexUpper(hex.data(), data.data(), RawLength{length});
+
+        std::vector<char16_t> units(length * 2);
+        for (size_t i = 0; i < units.size(); ++i)
+            units[i] = static_cast<char16_t>(i % 3 == 0 && hex[i] >= 'A' ? hex[i] | 0x20 : hex[i]);
+
+        std::vector<uint8_t> out(length);
+        REQUIRE(decode(out.data(), units.data(), RawLength{length}));
+        REQUIRE(out == data);
+
+        for (size_t i = 0; i < units.size(); ++i)
+        {
+            CAPTURE(i);
+            for (const char16_t wide : {char16_t{0x0100}, char16_t{0x0130}, char16_t{0xFF10}, char16_t{0x8000}})
+            {
+                const char16_t saved = units[i];
+                units[i] = wide;
+                REQUIRE_FALSE(decode(out.data(), units.data(), RawLength{length}));
+                units[i] = saved;
+            }
+        }
+    }
+}
+
+TEST_CASE("decodeHexBMI16")
+{
+    testHexDecoding16(decodeHexBMI16);
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("decodeHexVec16")
+{
+    testHexDecoding16(decodeHexVec16);
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("decodeHexNeon16")
+{
+    testHexDecoding16(decodeHexNeon16);
+}
+#endif
+
+#ifndef FAST_HEX_STATIC_SHARED_LIBRARY
+TEST_CASE("decode_auto16")
+{
+    testHexDecoding16(decode_auto16);
+}
+#endif
+
+TEST_CASE("decodeHexBMI16 invalid characters")
+{
+    // Not validated, as with the 8-bit decoders: only must not crash
+    const char16_t units[] = u"GG0z  \t\x01\xFF";
+    uint8_t out[sizeof(units) / sizeof(units[0]) / 2];
+    CHECK(decodeHexBMI16(out, units, RawLength{sizeof(out)}));
+}
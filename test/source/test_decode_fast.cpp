@@ -0,0 +1,120 @@
+#include "fast_hex/fast_hex.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+using namespace std::literals::string_view_literals;
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using DecodeFastFn = void (*)(uint8_t * FAST_HEX_RESTRICT, const uint8_t * FAST_HEX_RESTRICT);
+
+// Every digit in both cases, in every position
+std::vector<std::string> hex_inputs(size_t digits)
+{
+    constexpr auto alphabet = "0123456789abcdefABCDEF"sv;
+    std::vector<std::string> inputs{std::string(digits, '0'), std::string(digits, 'f'), std::string(digits, 'F')};
+    for (size_t shift = 0; shift < alphabet.size(); ++shift)
+    {
+        std::string hex(digits, '0');
+        for (size_t i = 0; i < digits; ++i)
+            hex[i] = alphabet[(i * 7 + shift) % alphabet.size()];
+        inputs.push_back(hex);
+    }
+    return inputs;
+}
+
+template <size_t Size, size_t Offset>
+struct Unaligned
+{
+    uint8_t pad[Offset];
+    uint8_t data[Size];
+    // Must not be written
+    uint8_t guard[8];
+};
+
+// Against decodeHexLUT4, from src and dest Offset bytes into a buffer
+template <size_t OutLength, size_t Offset>
+void run_decode_fast(DecodeFastFn decode_fast)
+{
+    for (const auto & hex : hex_inputs(OutLength * 2))
+    {
+        CAPTURE(hex);
+        Unaligned<OutLength * 2, Offset> src{};
+        std::memcpy(src.data, hex.data(), OutLength * 2);
+
+        Unaligned<OutLength, Offset> dest{};
+        std::memset(dest.guard, 0xA5, sizeof(dest.guard));
+        decode_fast(dest.data, src.data);
+
+        uint8_t expected[OutLength] = {};
+        decodeHexLUT4(expected, src.data, RawLength{OutLength});
+        REQUIRE(std::memcmp(dest.data, expected, OutLength) == 0);
+        for (uint8_t guard : dest.guard)
+            REQUIRE(guard == 0xA5);
+    }
+}
+
+template <size_t OutLength, size_t... Offset>
+void run_offsets(DecodeFastFn decode_fast, std::index_sequence<Offset...>)
+{
+    (run_decode_fast<OutLength, Offset + 1>(decode_fast), ...);
+}
+
+template <size_t OutLength>
+void run_tests(DecodeFastFn decode_fast)
+{
+    uint8_t dest[OutLength] = {};
+    const std::string hex = std::string("0123456789abcdef") + std::string(OutLength * 2 - 16, '7');
+    decode_fast(dest, reinterpret_cast<const uint8_t *>(hex.data()));
+    CHECK(dest[0] == 0x01);
+    CHECK(dest[7] == 0xEF);
+    CHECK(dest[OutLength - 1] == (OutLength == 8 ? 0xEF : 0x77));
+
+    run_offsets<OutLength>(decode_fast, std::make_index_sequence<15>{});
+}
+
+} // namespace
+
+TEST_SUITE("decodeHexFast")
+{
+#if defined(FAST_HEX_AVX)
+    TEST_CASE("decodeHex8 AVX Fast")
+    {
+        run_tests<8>(decodeHex8Fast);
+    }
+    TEST_CASE("decodeHex16 AVX Fast")
+    {
+        run_tests<16>(decodeHex16Fast);
+    }
+#endif
+#if defined(FAST_HEX_AVX2)
+    TEST_CASE("decodeHex32 AVX2 Fast")
+    {
+        run_tests<32>(decodeHex32Fast);
+    }
+#endif
+#if defined(FAST_HEX_NEON)
+    TEST_CASE("decodeHex8 NEON Fast")
+    {
+        run_tests<8>(decodeHex8Neon);
+    }
+    TEST_CASE("decodeHex16 NEON Fast")
+    {
+        run_tests<16>(decodeHex16Neon);
+    }
+    TEST_CASE("decodeHex32 NEON Fast")
+    {
+        run_tests<32>(decodeHex32Neon);
+    }
+#endif
+}
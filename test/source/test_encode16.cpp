@@ -0,0 +1,77 @@
+#ifdef FAST_HEX_STATIC_SHARED_LIBRARY
+#    include <fast_hex/fast_hex.hpp>
+#else
+#    include "fast_hex/fast_hex_inline.hpp"
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+template <typename CharT>
+using WideEncoder = void (*)(CharT *, const uint8_t *, RawLength);
+using Encoder = void (*)(uint8_t *, const uint8_t *, RawLength);
+
+// Compares against the 8-bit encoder widened in a second pass, and checks nothing is written past the end
+template <typename CharT>
+static void testHexEncodingWide(WideEncoder<CharT> encode, Encoder reference)
+{
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        CAPTURE(length);
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; ++i)
+            data[i] = static_cast<uint8_t>(i * 59 + 7);
+        std::vector<uint8_t> hex(length * 2);
+        reference(hex.data(), data.data(), RawLength{length});
+        std::vector<CharT> expected(hex.begin(), hex.end());
+        expected.push_back(CharT{0xFFFF});
+
+        std::vector<CharT> out(length * 2 + 1, CharT{0xFFFF});
+        encode(out.data(), data.data(), RawLength{length});
+        REQUIRE(out == expected);
+    }
+}
+
+TEST_CASE("encodeHexLower16/Upper16/Lower32/Upper32")
+{
+    testHexEncodingWide<char16_t>(encodeHexLower16, encodeHexLower);
+    testHexEncodingWide<char16_t>(encodeHexUpper16, encodeHexUpper);
+    testHexEncodingWide<char32_t>(encodeHexLower32, encodeHexLower);
+    testHexEncodingWide<char32_t>(encodeHexUpper32, encodeHexUpper);
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("encodeHexLowerVec16/UpperVec16/LowerVec32/UpperVec32")
+{
+    testHexEncodingWide<char16_t>(encodeHexLowerVec16, encodeHexLower);
+    testHexEncodingWide<char16_t>(encodeHexUpperVec16, encodeHexUpper);
+    testHexEncodingWide<char32_t>(encodeHexLowerVec32, encodeHexLower);
+    testHexEncodingWide<char32_t>(encodeHexUpperVec32, encodeHexUpper);
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("encodeHexNeonLower16/NeonUpper16/NeonLower32/NeonUpper32")
+{
+    testHexEncodingWide<char16_t>(encodeHexNeonLower16, encodeHexLower);
+    testHexEncodingWide<char16_t>(encodeHexNeonUpper16, encodeHexUpper);
+    testHexEncodingWide<char32_t>(encodeHexNeonLower32, encodeHexLower);
+    testHexEncodingWide<char32_t>(encodeHexNeonUpper32, encodeHexUpper);
+}
+#endif
+
+#ifndef FAST_HEX_STATIC_SHARED_LIBRARY
+TEST_CASE("encode_auto16/encode_auto32")
+{
+    testHexEncodingWide<char16_t>([](char16_t * d, const uint8_t * s, RawLength n) { encode_auto16(d, s, n, lower); }, encodeHexLower);
+    testHexEncodingWide<char16_t>([](char16_t * d, const uint8_t * s, RawLength n) { encode_auto16(d, s, n, upper); }, encodeHexUpper);
+    testHexEncodingWide<char32_t>([](char32_t * d, const uint8_t * s, RawLength n) { encode_auto32(d, s, n, lower); }, encodeHexLower);
+    testHexEncodingWide<char32_t>([](char32_t * d, const uint8_t * s, RawLength n) { encode_auto32(d, s, n, upper); }, encodeHexUpper);
+}
+#endif
@@ -0,0 +1,114 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#    include "fast_hex/fast_hex_file.hpp"
+
+#    include <cstdint>
+#    include <cstdio>
+#    include <filesystem>
+#    include <fstream>
+#    include <iterator>
+#    include <string>
+#    include <vector>
+
+#    include <doctest/doctest.h>
+
+#    if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#    endif
+
+namespace
+{
+
+struct TempDir
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("heks_test_file_" + std::to_string(::getpid()));
+
+    TempDir() { std::filesystem::create_directories(path); }
+    ~TempDir() { std::filesystem::remove_all(path); }
+
+    std::string operator/(const char * name) const { return (path / name).string(); }
+};
+
+void write_file(const std::string & path, const std::vector<uint8_t> & data)
+{
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+std::vector<uint8_t> read_file(const std::string & path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+std::vector<uint8_t> pattern(size_t length)
+{
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; ++i)
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    return data;
+}
+
+} // namespace
+
+TEST_SUITE("file")
+{
+    TEST_CASE("encode_file / decode_file round trip")
+    {
+        const TempDir dir;
+        const auto bin = dir / "in.bin";
+        const auto hex = dir / "out.hex";
+        const auto back = dir / "back.bin";
+
+        // Sizes around the page size, with and without chunked msync
+        for (const size_t length : {size_t{0}, size_t{1}, size_t{31}, size_t{4096}, size_t{100001}})
+        {
+            for (const size_t sync_chunk : {size_t{0}, size_t{1}, size_t{8192}})
+            {
+                CAPTURE(length);
+                CAPTURE(sync_chunk);
+                const auto data = pattern(length);
+                write_file(bin, data);
+                FileOptions options;
+                options.sync_chunk = sync_chunk;
+                options.huge_pages = sync_chunk == 1;
+
+                REQUIRE_FALSE(encode_file(bin.c_str(), hex.c_str(), upper, options));
+                std::vector<uint8_t> expected(length * 2);
+                encodeHexUpper(expected.data(), data.data(), RawLength{length});
+                REQUIRE(read_file(hex) == expected);
+
+                REQUIRE_FALSE(encode_file(bin.c_str(), hex.c_str(), lower, options));
+                encodeHexLower(expected.data(), data.data(), RawLength{length});
+                REQUIRE(read_file(hex) == expected);
+
+                REQUIRE_FALSE(decode_file(hex.c_str(), back.c_str(), options));
+                REQUIRE(read_file(back) == data);
+            }
+        }
+    }
+
+    TEST_CASE("the output is replaced")
+    {
+        const TempDir dir;
+        write_file(dir / "in.bin", {0xAB});
+        write_file(dir / "out.hex", pattern(1000));
+        REQUIRE_FALSE(encode_file((dir / "in.bin").c_str(), (dir / "out.hex").c_str(), lower));
+        REQUIRE(read_file(dir / "out.hex") == std::vector<uint8_t>{'a', 'b'});
+    }
+
+    TEST_CASE("errors")
+    {
+        const TempDir dir;
+        write_file(dir / "odd.hex", {'a', 'b', 'c'});
+        REQUIRE(decode_file((dir / "odd.hex").c_str(), (dir / "out.bin").c_str()) == std::errc::invalid_argument);
+        REQUIRE(encode_file((dir / "missing").c_str(), (dir / "out.hex").c_str(), lower) == std::errc::no_such_file_or_directory);
+        REQUIRE(encode_file((dir / "odd.hex").c_str(), (dir / "no/such/dir").c_str(), lower) == std::errc::no_such_file_or_directory);
+        REQUIRE(encode_file(dir.path.c_str(), (dir / "out.hex").c_str(), lower) == std::errc::invalid_argument);
+
+        // Writing over the input would destroy it
+        REQUIRE(encode_file((dir / "odd.hex").c_str(), (dir / "odd.hex").c_str(), lower) == std::errc::invalid_argument);
+        REQUIRE(read_file(dir / "odd.hex") == std::vector<uint8_t>{'a', 'b', 'c'});
+    }
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "fast_hex/fast_hex_inline.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+std::vector<uint8_t> sample(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i * 89 + 7);
+    return data;
+}
+
+// encode<N> / decode<N> against the runtime-length functions, with a guard byte after the output
+template <size_t N>
+void check_fixed()
+{
+    CAPTURE(N);
+    const auto data = sample(N);
+
+    std::string lower_text(N * 2 + 1, '#');
+    std::string upper_text(N * 2 + 1, '#');
+    encode<N, lower_t>(reinterpret_cast<uint8_t *>(lower_text.data()), data.data());
+    encode<N>(reinterpret_cast<uint8_t *>(upper_text.data()), data.data(), upper);
+    REQUIRE(lower_text.back() == '#');
+    REQUIRE(upper_text.back() == '#');
+    lower_text.pop_back();
+    upper_text.pop_back();
+
+    std::string expected(N * 2, '\0');
+    encodeHexLower(reinterpret_cast<uint8_t *>(expected.data()), data.data(), RawLength{N});
+    REQUIRE(lower_text == expected);
+    encodeHexUpper(reinterpret_cast<uint8_t *>(expected.data()), data.data(), RawLength{N});
+    REQUIRE(upper_text == expected);
+
+    for (const std::string & hex : {lower_text, upper_text})
+    {
+        std::vector<uint8_t> out(N + 1, 0xA5);
+        decode<N>(out.data(), reinterpret_cast<const uint8_t *>(hex.data()));
+        REQUIRE(out.back() == 0xA5);
+        out.pop_back();
+        REQUIRE(out == data);
+    }
+}
+
+template <size_t... N>
+void check_sizes(std::index_sequence<N...>)
+{
+    (check_fixed<N>(), ...);
+}
+
+} // namespace
+
+TEST_CASE("encode<N> / decode<N>")
+{
+    // Every block width, with and without an overlapping last block
+    check_sizes(std::make_index_sequence<101>{});
+    check_fixed<128>();
+    check_fixed<255>();
+}
@@ -0,0 +1,140 @@
+#include "fast_hex/fast_hex_format.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+std::vector<uint8_t> sample(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i * 89 + 7);
+    return data;
+}
+
+// Byte at a time, a separator in front of every group but the first
+std::string reference_hex(const std::vector<uint8_t> & data, bool upper_case, char separator = '\0', size_t group = 1)
+{
+    const char * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        if (separator != '\0' && i != 0 && i % group == 0)
+            hex += separator;
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0xF];
+    }
+    return hex;
+}
+
+heks_detail::HexFormatSpec parse(std::string_view text, bool expect_ok = true)
+{
+    heks_detail::HexFormatSpec spec;
+    bool ok = false;
+    const char * end = heks_detail::parseHexFormatSpec(text.data(), text.data() + text.size(), spec, ok);
+    CHECK(ok == expect_ok);
+    if (ok)
+        CHECK((end == text.data() + text.size() || *end == '}'));
+    return spec;
+}
+
+} // namespace
+
+TEST_CASE("hex format spec")
+{
+    CHECK_FALSE(parse("").has_case);
+    CHECK_FALSE(parse("}").has_separator);
+    CHECK(parse("X}").hex_case == heks_detail::HexCase::Upper);
+    CHECK(parse("x").hex_case == heks_detail::HexCase::Lower);
+    CHECK(parse(".16").max_bytes == 16);
+
+    const auto colons = parse(":X}");
+    CHECK(colons.separator == ':');
+    CHECK(colons.group == 1);
+    CHECK(colons.hex_case == heks_detail::HexCase::Upper);
+
+    const auto groups = parse("4 .32x}");
+    CHECK(groups.separator == ' ');
+    CHECK(groups.group == 4);
+    CHECK(groups.max_bytes == 32);
+
+    parse("4}", false);
+    parse("0:}", false);
+    parse(".}", false);
+    parse("xx}", false);
+    parse("::}", false);
+}
+
+TEST_CASE("hex format blocks")
+{
+    // Sizes around the 4 KiB block, with and without separators
+    for (size_t size : {0u, 1u, 31u, 1365u, 1366u, 2048u, 2049u, 5000u})
+    {
+        CAPTURE(size);
+        const auto data = sample(size);
+        for (const auto & [separator, group] : {std::pair{'\0', size_t{1}}, {':', size_t{1}}, {' ', size_t{4}}, {'-', size_t{1000}}})
+        {
+            CAPTURE(group);
+            const heks_detail::HexFormat format{heks_detail::HexCase::Upper, separator, group};
+            const std::string expected = reference_hex(data, true, separator, group);
+
+            std::string direct(expected.size(), '#');
+            char * end = heks_detail::writeHexGroups(direct.data(), data.data(), 0, size, format);
+            REQUIRE(end == direct.data() + direct.size());
+            REQUIRE(direct == expected);
+
+            std::string blocks;
+            heks_detail::formatHexBlocks(data.data(), size, format, [&](const char * block, size_t n) { blocks.append(block, n); });
+            REQUIRE(blocks == expected);
+        }
+    }
+}
+
+#if defined(FAST_HEX_TEST_FMT)
+TEST_CASE("fmt::formatter<hex_view>")
+{
+    const auto mac = sample(6);
+    const hex_view view(mac.data(), mac.size());
+    CHECK(fmt::format("{}", view) == reference_hex(mac, false));
+    CHECK(fmt::format("{:X}", view) == reference_hex(mac, true));
+    CHECK(fmt::format("{::X}", view) == reference_hex(mac, true, ':'));
+    CHECK(fmt::format("{:2-}", view) == reference_hex(mac, false, '-', 2));
+    CHECK(fmt::format("{:.2}", view) == reference_hex(sample(2), false));
+    CHECK(fmt::format("{:.100}", view) == reference_hex(mac, false));
+    CHECK(fmt::format("<{}>", hex_view(mac, upper, ' ')) == fmt::format("<{}>", reference_hex(mac, true, ' ')));
+    CHECK(fmt::format("{:x}", hex_view(mac, upper)) == reference_hex(mac, false));
+    CHECK(fmt::format("{}", hex_view()).empty());
+
+    // More than one block, and an output that cannot grow
+    const auto data = sample(10000);
+    CHECK(fmt::format("{: }", hex_view(data)) == reference_hex(data, false, ' '));
+    std::string truncated(100, '#');
+    const auto result = fmt::format_to_n(truncated.data(), truncated.size(), "{:X}", hex_view(data));
+    CHECK(result.size == 20000);
+    CHECK(truncated == reference_hex(data, true).substr(0, 100));
+}
+#endif // defined(FAST_HEX_TEST_FMT)
+
+#if defined(__cpp_lib_format)
+TEST_CASE("std::formatter<hex_view>")
+{
+    const auto mac = sample(6);
+    const hex_view view(mac.data(), mac.size());
+    CHECK(std::format("{}", view) == reference_hex(mac, false));
+    CHECK(std::format("{::X}", view) == reference_hex(mac, true, ':'));
+    CHECK(std::format("{:2-.4}", view) == reference_hex(sample(4), false, '-', 2));
+
+    const auto data = sample(10000);
+    CHECK(std::format("{:4 X}", hex_view(data)) == reference_hex(data, true, ' ', 4));
+}
+#endif // defined(__cpp_lib_format)
@@ -101,4 +101,9 @@ TEST_CASE("decodeHexVec_invalid")
 {
     testInvalidHexDecoding<decodeHexVec>();
 }
+
+TEST_CASE("decodeHexVecMaddubs_invalid")
+{
+    testInvalidHexDecoding<decodeHexVecMaddubs>();
+}
 #endif
@@ -0,0 +1,130 @@
+#include "fast_hex/fast_hex_nibble.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+std::vector<uint8_t> sample(size_t size, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::vector<uint8_t> data(size);
+    for (auto & byte : data)
+        byte = static_cast<uint8_t>(gen());
+    return data;
+}
+
+const uint8_t * bytes_of(std::string_view text)
+{
+    return reinterpret_cast<const uint8_t *>(text.data());
+}
+
+uint8_t nibble_at(const std::vector<uint8_t> & data, size_t i)
+{
+    return static_cast<uint8_t>(i % 2 == 0 ? data[i / 2] >> 4 : data[i / 2] & 0xF);
+}
+
+std::string encoded(const std::vector<uint8_t> & data, size_t len, size_t offset, bool upper_case)
+{
+    const char * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string out;
+    for (size_t i = offset; i < offset + len; ++i)
+        out += digits[nibble_at(data, i)];
+    return out;
+}
+
+std::string encode_padded_string(const std::vector<uint8_t> & data, size_t len, NibblePad side)
+{
+    std::string text(len, '\0');
+    encode_padded(reinterpret_cast<uint8_t *>(text.data()), data.data(), NibbleLength{len}, side);
+    return text;
+}
+
+} // namespace
+
+TEST_CASE("encode_nibbles")
+{
+    const auto data = sample(60, 1);
+    for (size_t offset = 0; offset < 4; ++offset)
+        for (size_t len = 0; len + offset <= 2 * data.size() && len <= 100; ++len)
+        {
+            CAPTURE(offset);
+            CAPTURE(len);
+            std::string upper_text(len + 1, '#');
+            encode_nibbles(reinterpret_cast<uint8_t *>(upper_text.data()), data.data(), NibbleLength{len}, offset);
+            CHECK(upper_text == encoded(data, len, offset, true) + '#');
+
+            std::string lower_text(len + 1, '#');
+            encode_nibbles(reinterpret_cast<uint8_t *>(lower_text.data()), data.data(), NibbleLength{len}, offset, lower);
+            CHECK(lower_text == encoded(data, len, offset, false) + '#');
+        }
+}
+
+TEST_CASE("decode_nibbles")
+{
+    const auto data = sample(60, 2);
+    for (size_t offset = 0; offset < 4; ++offset)
+        for (size_t len = 0; len + offset <= 2 * data.size() && len <= 100; ++len)
+        {
+            CAPTURE(offset);
+            CAPTURE(len);
+            const std::string text = encoded(data, len, 0, len % 3 == 0);
+            // Nibbles outside [offset, offset + len) keep their value
+            auto dest = sample(data.size(), 3);
+            const auto before = dest;
+            decode_nibbles(dest.data(), bytes_of(text), NibbleLength{len}, offset);
+            for (size_t i = 0; i < 2 * dest.size(); ++i)
+            {
+                CAPTURE(i);
+                REQUIRE(nibble_at(dest, i) == (i >= offset && i < offset + len ? nibble_at(data, i - offset) : nibble_at(before, i)));
+            }
+        }
+}
+
+TEST_CASE("encode_padded / decode_padded")
+{
+    uint8_t dest[8] = {};
+    CHECK(padded_size(NibbleLength{0}) == 0);
+    CHECK(padded_size(NibbleLength{3}) == 2);
+
+    CHECK(decode_padded(dest, bytes_of("ABC"), NibbleLength{3}, NibblePad::Left) == 2);
+    CHECK(dest[0] == 0x0A);
+    CHECK(dest[1] == 0xBC);
+    CHECK(decode_padded(dest, bytes_of("abc"), NibbleLength{3}, NibblePad::Right) == 2);
+    CHECK(dest[0] == 0xAB);
+    CHECK(dest[1] == 0xC0);
+
+    // EMV PAN: odd-length, padded with F on the right
+    CHECK(decode_padded(dest, bytes_of("476173900101011"), NibbleLength{15}, NibblePad::Right, 0xF) == 8);
+    CHECK(std::vector<uint8_t>(dest, dest + 8) == std::vector<uint8_t>{0x47, 0x61, 0x73, 0x90, 0x01, 0x01, 0x01, 0x1F});
+    CHECK(encode_padded_string({0x47, 0x61, 0x73, 0x90, 0x01, 0x01, 0x01, 0x1F}, 15, NibblePad::Right) == "476173900101011");
+    CHECK(encode_padded_string({0x0A, 0xBC}, 3, NibblePad::Left) == "ABC");
+    CHECK(encode_padded_string({0x0A, 0xBC}, 4, NibblePad::Left) == "0ABC");
+
+    std::mt19937 gen(4);
+    for (size_t len = 0; len <= 100; ++len)
+        for (const auto side : {NibblePad::Left, NibblePad::Right})
+        {
+            CAPTURE(len);
+            std::string text(len, '0');
+            for (auto & c : text)
+                c = "0123456789ABCDEF"[gen() % 16];
+            std::vector<uint8_t> bytes(padded_size(NibbleLength{len}) + 1, 0xA5);
+            REQUIRE(decode_padded(bytes.data(), bytes_of(text), NibbleLength{len}, side, 0x5) == padded_size(NibbleLength{len}));
+            REQUIRE(bytes.back() == 0xA5);
+            bytes.pop_back();
+            if (len % 2 != 0)
+                REQUIRE((side == NibblePad::Left ? bytes.front() >> 4 : bytes.back() & 0xF) == 0x5);
+            REQUIRE(encode_padded_string(bytes, len, side) == text);
+        }
+}
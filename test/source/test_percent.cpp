@@ -0,0 +1,207 @@
+#include "fast_hex/fast_hex_percent.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using DecodeFn = size_t (*)(uint8_t *, const uint8_t *, size_t);
+using EncodeFn = size_t (*)(uint8_t *, const uint8_t *, size_t, const PercentCharset &);
+
+// WHATWG percent-decode, a byte at a time
+std::string reference_decode(const std::string & text)
+{
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[i + 1])) != 0
+            && std::isxdigit(static_cast<unsigned char>(text[i + 2])) != 0)
+        {
+            out += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else
+            out += text[i];
+    }
+    return out;
+}
+
+std::string reference_encode(const std::string & text, std::string_view kept, bool upper_case)
+{
+    const char * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string out;
+    for (const char c : text)
+    {
+        if (kept.find(c) != std::string_view::npos)
+            out += c;
+        else
+        {
+            const auto byte = static_cast<uint8_t>(c);
+            out += '%';
+            out += digits[byte >> 4];
+            out += digits[byte & 0xF];
+        }
+    }
+    return out;
+}
+
+constexpr std::string_view unreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~";
+
+const uint8_t * bytes_of(const std::string & text)
+{
+    return reinterpret_cast<const uint8_t *>(text.data());
+}
+
+// Mostly escapes and the characters around them, valid or not, so that they cross block boundaries
+std::vector<std::string> decode_inputs()
+{
+    std::mt19937 gen(11);
+    constexpr std::string_view alphabet = "%%%%0123456789abcdefABCDEFgxz+/ \x80\xff";
+    std::vector<std::string> inputs{"", "%", "%%", "%4", "%41", "%4g", "%%41", "a%2", "%zz%41%"};
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        std::string text(size, ' ');
+        for (auto & c : text)
+            c = alphabet[gen() % alphabet.size()];
+        inputs.push_back(text);
+    }
+    // Long clean runs with an escape at every offset of a block
+    for (size_t offset = 0; offset < 40; ++offset)
+        inputs.push_back(std::string(offset, 'q') + "%2F" + std::string(70, 'q') + "%e9%");
+    return inputs;
+}
+
+template <DecodeFn Decode>
+void check_decode()
+{
+    for (const auto & text : decode_inputs())
+    {
+        CAPTURE(text);
+        const std::string expected = reference_decode(text);
+
+        std::vector<uint8_t> dest(text.size() + 1, 0xA5);
+        const size_t size = Decode(dest.data(), bytes_of(text), text.size());
+        REQUIRE(size == expected.size());
+        REQUIRE(std::string(dest.begin(), dest.begin() + static_cast<std::ptrdiff_t>(size)) == expected);
+        REQUIRE(dest.back() == 0xA5);
+
+        std::string in_place = text;
+        auto * data = reinterpret_cast<uint8_t *>(in_place.data());
+        in_place.resize(Decode(data, data, in_place.size()));
+        REQUIRE(in_place == expected);
+    }
+}
+
+template <EncodeFn Encode>
+void check_encode(bool upper_case)
+{
+    std::mt19937 gen(5);
+    std::vector<std::string> inputs;
+    std::string all_bytes;
+    for (int c = 0; c < 256; ++c)
+        all_bytes += static_cast<char>(c);
+    inputs.push_back(all_bytes);
+    for (size_t size = 0; size <= 200; ++size)
+    {
+        // From all unreserved to all escaped
+        std::string text(size, ' ');
+        for (auto & c : text)
+            c = gen() % 4 < size % 4 ? static_cast<char>(gen()) : unreserved[gen() % unreserved.size()];
+        inputs.push_back(text);
+    }
+
+    for (const auto & text : inputs)
+    {
+        CAPTURE(text);
+        const std::string expected = reference_encode(text, unreserved, upper_case);
+        std::vector<uint8_t> dest(text.size() * 3 + 1, 0xA5);
+        const size_t size = Encode(dest.data(), bytes_of(text), text.size(), percent_unreserved);
+        REQUIRE(size == expected.size());
+        REQUIRE(std::string(dest.begin(), dest.begin() + static_cast<std::ptrdiff_t>(size)) == expected);
+        REQUIRE(dest.back() == 0xA5);
+        REQUIRE(reference_decode(expected) == text);
+    }
+}
+
+} // namespace
+
+TEST_CASE("PercentCharset")
+{
+    for (int c = 0; c < 256; ++c)
+    {
+        CAPTURE(c);
+        const auto byte = static_cast<uint8_t>(c);
+        const bool is_unreserved = unreserved.find(static_cast<char>(c)) != std::string_view::npos;
+        const bool is_delimiter = std::string_view("!$&'()*+,;=:@/").find(static_cast<char>(c)) != std::string_view::npos;
+        CHECK(percent_unreserved.contains(byte) == is_unreserved);
+        CHECK(percent_path.contains(byte) == (is_unreserved || is_delimiter));
+    }
+    const auto high = PercentCharset{}.with("\x80\xff");
+    CHECK(high.contains(0x80));
+    CHECK(high.contains(0xFF));
+    CHECK_FALSE(high.contains(0x00));
+    CHECK_FALSE(high.contains(0x7F));
+}
+
+TEST_CASE("percent_decode scalar")
+{
+    check_decode<heks_detail::percentDecodeImpl>();
+}
+
+TEST_CASE("percent_encode scalar")
+{
+    check_encode<heks_detail::percentEncodeImpl<heks_detail::HexCase::Upper>>(true);
+    check_encode<heks_detail::percentEncodeImpl<heks_detail::HexCase::Lower>>(false);
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("percent_decode AVX2")
+{
+    check_decode<heks_detail::percentDecodeVecImpl>();
+}
+
+TEST_CASE("percent_encode AVX2")
+{
+    check_encode<heks_detail::percentEncodeVecImpl<heks_detail::HexCase::Upper>>(true);
+    check_encode<heks_detail::percentEncodeVecImpl<heks_detail::HexCase::Lower>>(false);
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("percent_decode NEON")
+{
+    check_decode<heks_detail::percentDecodeNeonImpl>();
+}
+
+TEST_CASE("percent_encode NEON")
+{
+    check_encode<heks_detail::percentEncodeNeonImpl<heks_detail::HexCase::Upper>>(true);
+    check_encode<heks_detail::percentEncodeNeonImpl<heks_detail::HexCase::Lower>>(false);
+}
+#endif
+
+TEST_CASE("percent_encode / percent_decode")
+{
+    const std::string query = "q=caf\xc3\xa9 & cr\xc3\xa8me/br\xc3\xbbl\xc3\xa9" "e?";
+    std::vector<uint8_t> url(query.size() * 3);
+    url.resize(percent_encode(url.data(), bytes_of(query), query.size(), percent_path));
+    CHECK(std::string(url.begin(), url.end()) == "q=caf%C3%A9%20&%20cr%C3%A8me/br%C3%BBl%C3%A9e%3F");
+
+    url.resize(query.size() * 3);
+    url.resize(percent_encode(url.data(), bytes_of(query), query.size(), percent_unreserved, lower));
+    CHECK(std::string(url.begin(), url.end()) == "q%3dcaf%c3%a9%20%26%20cr%c3%a8me%2fbr%c3%bbl%c3%a9e%3f");
+
+    url.resize(percent_decode(url.data(), url.data(), url.size()));
+    CHECK(std::string(url.begin(), url.end()) == query);
+}
@@ -0,0 +1,187 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#    include "fast_hex/fast_hex_pipeline.hpp"
+
+#    include <csignal>
+#    include <cstdint>
+#    include <cstdio>
+#    include <thread>
+#    include <vector>
+
+#    include <doctest/doctest.h>
+
+#    include <unistd.h>
+
+#    if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#    endif
+
+namespace
+{
+
+std::vector<uint8_t> pattern(size_t length)
+{
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; ++i)
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    return data;
+}
+
+struct Pipe
+{
+    int read = -1;
+    int write = -1;
+
+    Pipe()
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        read = fds[0];
+        write = fds[1];
+    }
+    ~Pipe()
+    {
+        close_read();
+        close_write();
+    }
+    void close_read()
+    {
+        if (read >= 0)
+            ::close(read);
+        read = -1;
+    }
+    void close_write()
+    {
+        if (write >= 0)
+            ::close(write);
+        write = -1;
+    }
+};
+
+// Runs f(in, out) with data fed into in in uneven pieces and returns what it wrote to out
+template <typename F>
+std::vector<uint8_t> through_pipes(const std::vector<uint8_t> & data, F f)
+{
+    Pipe in;
+    Pipe out;
+    std::thread feeder(
+        [&]
+        {
+            size_t done = 0;
+            for (size_t piece = 1; done < data.size(); piece = piece * 3 % 4093)
+            {
+                const auto n = ::write(in.write, data.data() + done, std::min(piece, data.size() - done));
+                if (n <= 0)
+                    break;
+                done += static_cast<size_t>(n);
+            }
+            in.close_write();
+        });
+    std::vector<uint8_t> result;
+    std::thread drain(
+        [&]
+        {
+            uint8_t buffer[1000];
+            ssize_t n = 0;
+            while ((n = ::read(out.read, buffer, sizeof(buffer))) > 0)
+                result.insert(result.end(), buffer, buffer + n);
+        });
+    f(in.read, out.write);
+    out.close_write();
+    feeder.join();
+    drain.join();
+    return result;
+}
+
+std::vector<PipelineBackend> backends()
+{
+    std::vector<PipelineBackend> result{PipelineBackend::Threads};
+    if (Pipeline({.backend = PipelineBackend::IoUring}).backend() == PipelineBackend::IoUring)
+        result.push_back(PipelineBackend::IoUring);
+    return result;
+}
+
+} // namespace
+
+TEST_SUITE("pipeline")
+{
+    TEST_CASE("encode and decode through pipes")
+    {
+        for (const auto backend : backends())
+        {
+            for (const size_t buffers : {size_t{3}, size_t{8}})
+            {
+                Pipeline pipeline({.chunk_size = 1000, .buffers = buffers, .backend = backend});
+                REQUIRE(pipeline.backend() == backend);
+                // The same pipeline is reused
+                for (const size_t length : {size_t{0}, size_t{1}, size_t{999}, size_t{1000}, size_t{1001}, size_t{54321}})
+                {
+                    CAPTURE(static_cast<int>(backend));
+                    CAPTURE(buffers);
+                    CAPTURE(length);
+                    const auto data = pattern(length);
+                    std::vector<uint8_t> expected(length * 2);
+                    encodeHexUpper(expected.data(), data.data(), RawLength{length});
+
+                    std::error_code ec;
+                    const auto hex = through_pipes(data, [&](int in, int out) { ec = pipeline.encode(in, out, upper); });
+                    REQUIRE_FALSE(ec);
+                    REQUIRE(hex == expected);
+
+                    const auto binary = through_pipes(hex, [&](int in, int out) { ec = pipeline.decode(in, out); });
+                    REQUIRE_FALSE(ec);
+                    REQUIRE(binary == data);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("errors")
+    {
+        std::signal(SIGPIPE, SIG_IGN);
+        for (const auto backend : backends())
+        {
+            CAPTURE(static_cast<int>(backend));
+            Pipeline pipeline({.chunk_size = 100, .buffers = 3, .backend = backend});
+
+            // Odd hex input: the complete pairs are written
+            const std::vector<uint8_t> odd{'a', 'b', 'c', 'd', 'e'};
+            std::error_code ec;
+            const auto binary = through_pipes(odd, [&](int in, int out) { ec = pipeline.decode(in, out); });
+            REQUIRE(ec == std::errc::invalid_argument);
+            REQUIRE(binary == std::vector<uint8_t>{0xAB, 0xCD});
+
+            // Nobody reads the output
+            Pipe in;
+            Pipe out;
+            out.close_read();
+            std::thread feeder(
+                [&]
+                {
+                    const auto data = pattern(10000);
+                    static_cast<void>(::write(in.write, data.data(), data.size()));
+                    in.close_write();
+                });
+            REQUIRE(pipeline.encode(in.read, out.write, lower) == std::errc::broken_pipe);
+            feeder.join();
+
+            // Nobody reads the output and the input stays open: the pending read is cancelled
+            {
+                Pipe open_in;
+                const auto data = pattern(150);
+                REQUIRE(::write(open_in.write, data.data(), data.size()) == 150);
+                REQUIRE(pipeline.encode(open_in.read, out.write, lower) == std::errc::broken_pipe);
+            }
+            // and nothing of it is left behind for the next run
+            const auto data = pattern(1234);
+            std::vector<uint8_t> expected(data.size() * 2);
+            encodeHexLower(expected.data(), data.data(), RawLength{data.size()});
+            REQUIRE(through_pipes(data, [&](int in_fd, int out_fd) { ec = pipeline.encode(in_fd, out_fd, lower); }) == expected);
+            REQUIRE_FALSE(ec);
+
+            REQUIRE(pipeline.encode(-1, out.write, lower) == std::errc::bad_file_descriptor);
+        }
+    }
+}
+
+#endif
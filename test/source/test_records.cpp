@@ -0,0 +1,266 @@
+#include "fast_hex/fast_hex_records.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+std::vector<uint8_t> sample(size_t size, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::vector<uint8_t> data(size);
+    for (auto & byte : data)
+        byte = static_cast<uint8_t>(gen());
+    return data;
+}
+
+const uint8_t * bytes_of(std::string_view text)
+{
+    return reinterpret_cast<const uint8_t *>(text.data());
+}
+
+// Image as decoded, byte by address, and the runs passed to the sink
+struct Collected
+{
+    std::map<uint32_t, uint8_t> bytes;
+    size_t runs = 0;
+    size_t largest = 0;
+
+    void operator()(uint32_t address, const uint8_t * data, size_t size)
+    {
+        ++runs;
+        largest = std::max(largest, size);
+        for (size_t i = 0; i < size; ++i)
+            bytes[address + static_cast<uint32_t>(i)] = data[i];
+    }
+};
+
+std::string encode(RecordFormat format, const std::vector<uint8_t> & data, uint32_t address, const RecordOptions & options = {})
+{
+    RecordEncoder encoder(format, options);
+    std::string text(encoder.max_encoded_size(data.size()), '\0');
+    auto * out = reinterpret_cast<uint8_t *>(text.data());
+    size_t size = encoder.encode(out, data.data(), data.size(), address);
+    size += encoder.finish(out + size);
+    text.resize(size);
+    return text;
+}
+
+// Decodes text in chunks of random sizes up to max_chunk
+std::error_code decode(RecordFormat format, std::string_view text, Collected & collected, size_t max_chunk, uint32_t seed, size_t * line = nullptr)
+{
+    std::mt19937 gen(seed);
+    RecordDecoder decoder(format, 4096);
+    for (size_t done = 0; done < text.size();)
+    {
+        const size_t n = std::min<size_t>(text.size() - done, 1 + gen() % max_chunk);
+        if (decoder.decode(bytes_of(text) + done, n, collected))
+            break;
+        done += n;
+    }
+    const auto ec = decoder.finish(collected);
+    if (line != nullptr)
+        *line = decoder.line();
+    return ec;
+}
+
+std::error_code decode(RecordFormat format, std::string_view text, size_t * line = nullptr)
+{
+    Collected collected;
+    return decode(format, text, collected, text.size() + 1, 0, line);
+}
+
+} // namespace
+
+TEST_CASE("record byte sums and digit checks")
+{
+    const auto data = sample(300, 3);
+    std::string digits(300, 'a');
+    for (size_t i = 0; i < digits.size(); ++i)
+        digits[i] = "0123456789abcdefABCDEF"[data[i] % 22];
+    for (size_t len = 0; len <= data.size(); ++len)
+    {
+        CAPTURE(len);
+        const uint32_t sum = heks_detail::byteSumScalar(data.data(), len);
+        CHECK(heks_detail::byteSum(data.data(), len) == sum);
+        CHECK(heks_detail::allHexDigits(bytes_of(digits), len));
+        CHECK(heks_detail::allHexDigitsSWAR(bytes_of(digits), len));
+#if defined(FAST_HEX_AVX2)
+        CHECK(heks_detail::byteSumVec(data.data(), len) == sum);
+#endif
+#if defined(FAST_HEX_NEON)
+        CHECK(heks_detail::byteSumNeon(data.data(), len) == sum);
+#endif
+    }
+    // One character that is not a digit, at every position of the first 70
+    for (size_t len = 1; len <= 70; ++len)
+        for (size_t at = 0; at < len; ++at)
+            for (const char c : {'g', 'G', '/', ':', '\n', '\x80'})
+            {
+                std::string text = digits.substr(0, len);
+                text[at] = c;
+                CAPTURE(len);
+                CAPTURE(at);
+                CHECK_FALSE(heks_detail::allHexDigits(bytes_of(text), len));
+                CHECK_FALSE(heks_detail::allHexDigitsSWAR(bytes_of(text), len));
+            }
+}
+
+TEST_CASE("ihex_encode")
+{
+    std::vector<uint8_t> data(40);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 7);
+    // Split at the 64 KiB boundary, with an extended linear address record
+    CHECK(encode(RecordFormat::IntelHex, data, 0xFFF0)
+          == ":10FFF00000070E151C232A31383F464D545B6269B9\n"
+             ":020000040001F9\n"
+             ":1000000070777E858C939AA1A8AFB6BDC4CBD2D9A8\n"
+             ":08001000E0E7EEF5FC030A1124\n"
+             ":00000001FF\n");
+
+    RecordEncoder encoder(RecordFormat::IntelHex, {.record_size = 32, .crlf = true});
+    std::string text(encoder.max_encoded_size(data.size()), '\0');
+    auto * out = reinterpret_cast<uint8_t *>(text.data());
+    size_t size = encoder.encode(out, data.data(), 3, 0x12340000);
+    size += encoder.encode(out + size, data.data() + 3, 2);
+    CHECK(encoder.next_address() == 0x12340005);
+    size += encoder.finish(out + size, 0x12345678);
+    text.resize(size);
+    CHECK(text
+          == ":020000041234B4\r\n"
+             ":0300000000070EE8\r\n"
+             ":02000300151CCA\r\n"
+             ":0400000512345678E3\r\n"
+             ":00000001FF\r\n");
+
+    std::vector<uint8_t> whole(ihex_encoded_size(data.size()));
+    whole.resize(ihex_encode(whole.data(), data.data(), data.size(), 0xFFF0));
+    CHECK(std::string(whole.begin(), whole.end()) == encode(RecordFormat::IntelHex, data, 0xFFF0));
+}
+
+TEST_CASE("srec_encode")
+{
+    std::vector<uint8_t> data(40);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 7);
+    // S1 records up to 0xFFFF, then S2 and an S8 termination record
+    CHECK(encode(RecordFormat::SRecord, data, 0xFFF0, {.srec_header = "r.srec"})
+          == "S0090000722E73726563A9\n"
+             "S113FFF000070E151C232A31383F464D545B6269B5\n"
+             "S21401000070777E858C939AA1A8AFB6BDC4CBD2D9A2\n"
+             "S20C010010E0E7EEF5FC030A111E\n"
+             "S804000000FB\n");
+    CHECK(encode(RecordFormat::SRecord, {}, 0) == "S9030000FC\n");
+    CHECK(encode(RecordFormat::SRecord, {0xAB}, 0x100, {.srec_address_bytes = 4}) == "S30600000100AB4D\nS70500000000FA\n");
+
+    std::vector<uint8_t> whole(srec_encoded_size(data.size()));
+    whole.resize(srec_encode(whole.data(), data.data(), data.size(), 0xFFF0));
+    CHECK(std::string(whole.begin(), whole.end()) == encode(RecordFormat::SRecord, data, 0xFFF0));
+}
+
+TEST_CASE("RecordDecoder round trip")
+{
+    std::mt19937 gen(17);
+    for (const auto format : {RecordFormat::IntelHex, RecordFormat::SRecord})
+        for (int round = 0; round < 60; ++round)
+        {
+            CAPTURE(round);
+            const auto data = sample(gen() % 5000, static_cast<uint32_t>(round));
+            // Near the 64 KiB and 16 MiB boundaries and the end of the address space
+            const uint32_t bases[] = {0, 0xFF00, 0xFFFF00, 0xFFFFE000};
+            const uint32_t address = bases[round % 4] + static_cast<uint32_t>(gen() % 512);
+            const RecordOptions options{
+                .record_size = 1 + gen() % 255, .crlf = round % 2 == 0, .srec_address_bytes = 2 + gen() % 3, .srec_header = "image"};
+            const std::string text = encode(format, data, address, options);
+
+            Collected collected;
+            REQUIRE_FALSE(decode(format, text, collected, 1 + gen() % 700, static_cast<uint32_t>(round)));
+            REQUIRE(collected.bytes.size() == data.size());
+            REQUIRE(collected.largest <= 4096);
+            size_t i = 0;
+            for (const auto & [at, byte] : collected.bytes)
+            {
+                REQUIRE(at == address + i);
+                REQUIRE(byte == data[i++]);
+            }
+            // Runs end where the next record does not fit in the buffer
+            CHECK(collected.runs <= data.size() / (4096 - 255) + 1);
+        }
+}
+
+TEST_CASE("RecordDecoder Intel HEX records")
+{
+    // objcopy style: extended segment addresses, lower case digits, no line end after the last record
+    const std::string text = ":0100000011EE\r\n:020000021000EC\n\n:02000000ab4C07\n:0400000300100020C9\n:00000001ff";
+    RecordDecoder decoder(RecordFormat::IntelHex);
+    Collected collected;
+    CHECK_FALSE(decoder.decode(bytes_of(text), text.size(), collected));
+    CHECK_FALSE(decoder.ended());
+    CHECK_FALSE(decoder.finish(collected));
+    CHECK(decoder.ended());
+    CHECK(collected.bytes == std::map<uint32_t, uint8_t>{{0, 0x11}, {0x10000, 0xAB}, {0x10001, 0x4C}});
+    CHECK(decoder.start_address() == 0x120);
+
+    // Anything after the end of file record is ignored
+    CHECK_FALSE(decode(RecordFormat::IntelHex, ":00000001FF\njunk"));
+    CHECK_FALSE(decode(RecordFormat::IntelHex, ""));
+
+    size_t line = 0;
+    const std::string bad_records[] = {
+        ":0100000011EF\n",   // checksum
+        ":01000000G1EE\n",   // digit
+        ":0100000011EE \n",  // line end
+        ":0200000011EE\n",   // count
+        ":00000006FA\n",     // type
+        ":020000010000FD\n", // end of file record with data
+        "S00000000000\n",    // S-record
+        ":01000000",         // truncated
+    };
+    for (const auto & bad : bad_records)
+    {
+        CAPTURE(bad);
+        CHECK(decode(RecordFormat::IntelHex, ":00000000" "00\n\n" + bad, &line) == std::errc::invalid_argument);
+        CHECK(line == 3);
+    }
+}
+
+TEST_CASE("RecordDecoder S-records")
+{
+    const std::string text = "S0030000FC\r\nS1040010AA41\nS20501000011E8\nS5030002FA\nS70500000123D6\nS1040010AA41\n";
+    RecordDecoder decoder(RecordFormat::SRecord);
+    Collected collected;
+    CHECK_FALSE(decoder.decode(bytes_of(text), text.size(), collected));
+    CHECK(decoder.ended());
+    CHECK_FALSE(decoder.finish(collected));
+    CHECK(collected.bytes == std::map<uint32_t, uint8_t>{{0x10, 0xAA}, {0x10000, 0x11}});
+    CHECK(decoder.start_address() == 0x123);
+
+    const std::string bad_records[] = {
+        "S1040010AA42\n", // checksum
+        "S4030000FC\n",   // type
+        "S1020010ED\n",   // count below the address size
+        "Sx030000FC\n",   // type
+        ":00000001FF\n",  // Intel HEX
+        "S10400",         // truncated
+    };
+    for (const auto & bad : bad_records)
+    {
+        CAPTURE(bad);
+        size_t line = 0;
+        CHECK(decode(RecordFormat::SRecord, "S0030000FC\n" + bad, &line) == std::errc::invalid_argument);
+        CHECK(line == 2);
+    }
+}
@@ -0,0 +1,165 @@
+#include "fast_hex/fast_hex_scan.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+using MaskFn = uint64_t (*)(const uint8_t *);
+
+struct Run
+{
+    size_t offset;
+    size_t length;
+    bool operator==(const Run &) const = default;
+};
+
+std::vector<Run> reference_runs(const std::string & text, size_t min_len)
+{
+    std::vector<Run> runs;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (std::isxdigit(static_cast<unsigned char>(text[i])) == 0)
+        {
+            ++i;
+            continue;
+        }
+        const size_t start = i;
+        while (i < text.size() && std::isxdigit(static_cast<unsigned char>(text[i])) != 0)
+            ++i;
+        if (i - start >= min_len)
+            runs.push_back({start, i - start});
+    }
+    return runs;
+}
+
+template <MaskFn Mask>
+std::vector<Run> runs_of(const std::string & text, size_t min_len)
+{
+    std::vector<Run> runs;
+    const size_t count = heks_detail::findHexRunsImpl<Mask>(
+        reinterpret_cast<const uint8_t *>(text.data()), text.size(), min_len, [&](HexRun run) { runs.push_back({run.offset, run.length}); });
+    REQUIRE(count == runs.size());
+    return runs;
+}
+
+template <MaskFn Mask>
+void check_mask()
+{
+    // Every byte value in every position of the block
+    for (int c = 0; c < 256; ++c)
+    {
+        CAPTURE(c);
+        const bool digit = std::isxdigit(c) != 0;
+        REQUIRE(heks_detail::isHexDigit(static_cast<uint8_t>(c)) == digit);
+        for (size_t position = 0; position < 64; ++position)
+        {
+            std::vector<uint8_t> block(64, static_cast<uint8_t>(position % 2 != 0 ? 'G' : 'a'));
+            block[position] = static_cast<uint8_t>(c);
+            uint64_t expected = 0;
+            for (size_t k = 0; k < 64; ++k)
+                expected |= uint64_t{std::isxdigit(block[k]) != 0} << k;
+            REQUIRE(Mask(block.data()) == expected);
+        }
+    }
+}
+
+template <MaskFn Mask>
+void check_runs()
+{
+    std::mt19937 gen(7);
+    constexpr std::string_view alphabet = "0123456789abcdefABCDEF -_:xg/\n\x80\xff";
+    for (size_t size = 0; size <= 300; ++size)
+    {
+        CAPTURE(size);
+        std::string text(size, ' ');
+        // Mostly digits, so that runs cross block boundaries
+        for (auto & c : text)
+            c = alphabet[gen() % (gen() % 4 == 0 ? alphabet.size() : 22)];
+        for (size_t min_len : {0u, 1u, 2u, 3u, 8u, 63u, 64u, 65u, 100u})
+        {
+            CAPTURE(min_len);
+            REQUIRE(runs_of<Mask>(text, min_len) == reference_runs(text, min_len));
+        }
+    }
+
+    // Runs that fill whole blocks, end at a block boundary or at the end of the text
+    const std::string block(64, 'f');
+    CHECK(runs_of<Mask>(block + block, 1) == std::vector<Run>{{0, 128}});
+    CHECK(runs_of<Mask>(block + " " + block, 1) == std::vector<Run>{{0, 64}, {65, 64}});
+    CHECK(runs_of<Mask>(" " + block, 1) == std::vector<Run>{{1, 64}});
+}
+
+} // namespace
+
+TEST_CASE("hex digit mask scalar")
+{
+    check_mask<heks_detail::hexDigitMask>();
+}
+
+TEST_CASE("find_hex_runs scalar")
+{
+    check_runs<heks_detail::hexDigitMask>();
+}
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("hex digit mask AVX2")
+{
+    check_mask<heks_detail::hexDigitMaskVec>();
+}
+
+TEST_CASE("find_hex_runs AVX2")
+{
+    check_runs<heks_detail::hexDigitMaskVec>();
+}
+#endif
+
+#if defined(FAST_HEX_NEON)
+TEST_CASE("hex digit mask NEON")
+{
+    check_mask<heks_detail::hexDigitMaskNeon>();
+}
+
+TEST_CASE("find_hex_runs NEON")
+{
+    check_runs<heks_detail::hexDigitMaskNeon>();
+}
+#endif
+
+TEST_CASE("decode_hex_runs")
+{
+    const std::string log = "2024-05-01 trace=4BF92F3577B34DA6A3CE929D0E0E4736 span=00f067aa0ba902b7 addr=0x7ffe1 ok";
+    std::vector<uint8_t> dest((log.size() + 1) / 2);
+    std::vector<std::string> found;
+    std::vector<std::vector<uint8_t>> decoded;
+    const size_t count = decode_hex_runs(
+        dest.data(),
+        reinterpret_cast<const uint8_t *>(log.data()),
+        log.size(),
+        5,
+        [&](HexRun run, const uint8_t * bytes, size_t size)
+        {
+            found.push_back(log.substr(run.offset, run.length));
+            decoded.emplace_back(bytes, bytes + size);
+        });
+    CHECK(count == 3);
+    CHECK(found == std::vector<std::string>{"4BF92F3577B34DA6A3CE929D0E0E4736", "00f067aa0ba902b7", "7ffe1"});
+    REQUIRE(decoded.size() == 3);
+    CHECK(decoded[0].size() == 16);
+    CHECK(decoded[0][0] == 0x4B);
+    CHECK(decoded[0][15] == 0x36);
+    CHECK(decoded[1] == std::vector<uint8_t>{0x00, 0xf0, 0x67, 0xaa, 0x0b, 0xa9, 0x02, 0xb7});
+    CHECK(decoded[2] == std::vector<uint8_t>{0x07, 0xff, 0xe1});
+}
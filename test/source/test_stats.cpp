@@ -0,0 +1,113 @@
+#include "fast_hex/fast_hex_inline.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+TEST_SUITE("stats")
+{
+    TEST_CASE("calls, bytes and sizes per entry point")
+    {
+        std::vector<uint8_t> binary(100, 0xAB);
+        std::vector<uint8_t> hex(200, 'f');
+
+        stats_reset();
+        encodeHexLower(hex.data(), binary.data(), RawLength{5});
+        encodeHexLower(hex.data(), binary.data(), RawLength{7});
+        encodeHexUpper(hex.data(), binary.data(), RawLength{64});
+        decodeHexLUT4(binary.data(), hex.data(), RawLength{0});
+
+        const auto snapshot = stats_snapshot();
+        const auto & lower = snapshot[StatsPath::EncodeHexLower];
+        REQUIRE(lower.calls == 2);
+        REQUIRE(lower.bytes == 12);
+        REQUIRE(lower.sizes[stats_size_bucket(5)] == 2); // 5 and 7 share [4, 8)
+        const auto & upper = snapshot[StatsPath::EncodeHexUpper];
+        REQUIRE(upper.calls == 1);
+        REQUIRE(upper.bytes == 64);
+        REQUIRE(upper.sizes[7] == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexLUT4].calls == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexLUT4].sizes[0] == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexBMI].calls == 0);
+
+        stats_reset();
+        const auto after_reset = stats_snapshot();
+        REQUIRE(after_reset[StatsPath::EncodeHexLower].calls == 0);
+        REQUIRE(after_reset[StatsPath::EncodeHexLower].sizes[stats_size_bucket(5)] == 0);
+    }
+
+    TEST_CASE("size buckets")
+    {
+        REQUIRE(stats_size_bucket(0) == 0);
+        REQUIRE(stats_size_bucket(1) == 1);
+        REQUIRE(stats_size_bucket(2) == 2);
+        REQUIRE(stats_size_bucket(3) == 2);
+        REQUIRE(stats_size_bucket(4) == 3);
+        REQUIRE(stats_size_bucket(size_t{1} << 40) == stats_size_buckets - 1);
+    }
+
+#if defined(FAST_HEX_AVX2)
+    TEST_CASE("fallbacks")
+    {
+        std::vector<uint8_t> binary(100, 0x5A);
+        std::vector<uint8_t> hex(200, '5');
+
+        stats_reset();
+        encodeHexLowerVec(hex.data(), binary.data(), RawLength{40}); // 2 blocks + 8 byte tail
+        encodeHexLowerVec(hex.data(), binary.data(), RawLength{32}); // no tail
+        decodeHexVec(binary.data(), hex.data(), RawLength{70}); // 2 blocks + 6 byte tail
+        decode_auto(binary.data(), hex.data(), RawLength{33});
+
+        const auto snapshot = stats_snapshot();
+        REQUIRE(snapshot[StatsPath::EncodeHexLowerVec].calls == 2);
+        REQUIRE(snapshot[StatsPath::EncodeHexLowerVec].bytes == 72);
+        REQUIRE(snapshot[StatsPath::EncodeHexVecTail].calls == 1);
+        REQUIRE(snapshot[StatsPath::EncodeHexVecTail].bytes == 8);
+        REQUIRE(snapshot[StatsPath::EncodeHexLower].calls == 0);
+
+        // decode_auto is counted once, not again under the kernel it dispatches to
+        REQUIRE(snapshot[StatsPath::DecodeAuto].calls == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexVec].calls == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexVecTail].calls == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexVecTail].bytes == 6);
+        // decode_auto runs decodeHexVecMaddubs on AVX2
+        REQUIRE(snapshot[StatsPath::DecodeHexVecMaddubsTail].calls == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexVecMaddubsTail].bytes == 1);
+        REQUIRE(snapshot[StatsPath::DecodeHexBMI].calls == 0);
+    }
+#endif
+
+    TEST_CASE("threads")
+    {
+        constexpr size_t threads = 4;
+        constexpr size_t calls = 1000;
+        stats_reset();
+
+        auto work = []
+        {
+            uint8_t binary[3] = {1, 2, 3};
+            uint8_t hex[6];
+            for (size_t i = 0; i < calls; ++i)
+                encode_auto(hex, binary, RawLength{3}, lower);
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back(work);
+        for (auto & worker : workers)
+            worker.join();
+        REQUIRE(stats_snapshot()[StatsPath::EncodeAuto].calls == threads * calls);
+
+        // Blocks of exited threads are reused, their counts are kept
+        std::thread(work).join();
+        const auto snapshot = stats_snapshot();
+        REQUIRE(snapshot[StatsPath::EncodeAuto].calls == (threads + 1) * calls);
+        REQUIRE(snapshot[StatsPath::EncodeAuto].bytes == (threads + 1) * calls * 3);
+    }
+}
@@ -0,0 +1,123 @@
+#include "fast_hex/fast_hex_tune.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+// encode_auto/decode_auto against the scalar kernels, over lengths covering every bucket
+void check_auto_functions()
+{
+    constexpr size_t lengths[] = {0, 1, 2, 3, 5, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 255, 256, 1000, 4097, 70000};
+    for (const size_t length : lengths)
+    {
+        std::vector<uint8_t> binary(length);
+        for (size_t i = 0; i < length; ++i)
+            binary[i] = static_cast<uint8_t>(i * 7 + 3);
+
+        std::vector<uint8_t> expected_lower(length * 2), expected_upper(length * 2);
+        encodeHexLower(expected_lower.data(), binary.data(), RawLength{length});
+        encodeHexUpper(expected_upper.data(), binary.data(), RawLength{length});
+
+        std::vector<uint8_t> hex_lower(length * 2), hex_upper(length * 2), decoded(length);
+        encode_auto(hex_lower.data(), binary.data(), RawLength{length}, lower);
+        encode_auto(hex_upper.data(), binary.data(), RawLength{length}, upper);
+        decode_auto(decoded.data(), hex_upper.data(), RawLength{length});
+
+        CAPTURE(length);
+        REQUIRE(hex_lower == expected_lower);
+        REQUIRE(hex_upper == expected_upper);
+        REQUIRE(decoded == binary);
+    }
+}
+
+} // namespace
+
+TEST_SUITE("tune")
+{
+    TEST_CASE("tune installs a dispatch table")
+    {
+        const auto table = tune(TuneOptions{std::chrono::microseconds{20}});
+        REQUIRE(installed_tuning() == table);
+        check_auto_functions();
+
+        reset_tuning();
+        REQUIRE(!installed_tuning());
+        check_auto_functions();
+    }
+
+    TEST_CASE("every kernel through the dispatch table")
+    {
+        for (size_t i = 0; i < std::size(heks_detail::encode_candidates); ++i)
+        {
+            CAPTURE(heks_detail::encode_candidates[i].name);
+            TuneTable table;
+            table.encode.fill(static_cast<uint8_t>(i));
+            install_tuning(table);
+            check_auto_functions();
+        }
+        for (size_t i = 0; i < std::size(heks_detail::decode_candidates); ++i)
+        {
+            CAPTURE(heks_detail::decode_candidates[i].name);
+            TuneTable table;
+            table.decode.fill(static_cast<uint8_t>(i));
+            install_tuning(table);
+            check_auto_functions();
+        }
+        reset_tuning();
+    }
+
+    TEST_CASE("dump and parse")
+    {
+        TuneTable table;
+        for (size_t bucket = 0; bucket < heks_detail::tune_buckets; ++bucket)
+        {
+            table.encode[bucket] = static_cast<uint8_t>(bucket % std::size(heks_detail::encode_candidates));
+            table.decode[bucket] = static_cast<uint8_t>(bucket % std::size(heks_detail::decode_candidates));
+        }
+        const auto text = dump_tuning(table);
+        REQUIRE(parse_tuning(text) == table);
+
+        // Missing bucket
+        REQUIRE(!parse_tuning(text.substr(0, text.rfind('\n', text.size() - 2) + 1)));
+        // Unknown kernel
+        auto unknown = text;
+        unknown.replace(unknown.find("decodeHexLUT"), 12, "decodeHexXYZ");
+        REQUIRE(!parse_tuning(unknown));
+        REQUIRE(!parse_tuning("garbage"));
+        REQUIRE(!parse_tuning(""));
+    }
+
+    TEST_CASE("profile file")
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "heks_test_tune.profile").string();
+        std::filesystem::remove(path);
+        REQUIRE(!load_tuning(path));
+
+        // Measures and saves
+        const auto measured = tune(path, TuneOptions{std::chrono::microseconds{20}});
+        REQUIRE(load_tuning(path) == measured);
+
+        // Loads the saved profile instead of measuring
+        TuneTable cached;
+        cached.decode.fill(static_cast<uint8_t>(std::size(heks_detail::decode_candidates) - 1));
+        REQUIRE(save_tuning(cached, path));
+        REQUIRE(tune(path) == cached);
+        REQUIRE(installed_tuning() == cached);
+        check_auto_functions();
+
+        reset_tuning();
+        std::filesystem::remove(path);
+    }
+}
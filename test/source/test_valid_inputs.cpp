@@ -5,10 +5,12 @@
 #endif
 
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <doctest/doctest.h>
 
@@ -328,6 +330,10 @@ TEST_CASE("decodeHexVec_valid")
 {
     testHexDecoding<decodeHexVec>();
 }
+TEST_CASE("decodeHexVecMaddubs_valid")
+{
+    testHexDecoding<decodeHexVecMaddubs>();
+}
 #endif
 
 #if defined(FAST_HEX_NEON)
@@ -368,6 +374,77 @@ TEST_CASE("decodeHexBMI_valid")
     testHexDecoding<decodeHexBMI>();
 }
 
+TEST_CASE("decodeHexSWAR_valid")
+{
+    testHexDecoding<decodeHexSWAR>();
+}
+
+TEST_CASE("encodeHexSWAR")
+{
+    testHexEncoding<encodeHexLowerSWAR, encodeHexUpperSWAR>();
+}
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+TEST_CASE("decodeHexGeneric_valid")
+{
+    testHexDecoding<decodeHexGeneric>();
+}
+
+TEST_CASE("encodeHexGeneric")
+{
+    testHexEncoding<encodeHexLowerGeneric, encodeHexUpperGeneric>();
+}
+#endif
+
+template <auto EncodeLower, auto EncodeUpper, auto Decode>
+void testLengths()
+{
+    // Every length around the 8 and 16-byte blocks, against the table versions, with mixed case digits
+    std::vector<uint8_t> raw(100);
+    for (size_t i = 0; i < raw.size(); ++i)
+        raw[i] = static_cast<uint8_t>(i * 167 + 13);
+    for (size_t len = 0; len <= raw.size(); ++len)
+    {
+        CAPTURE(len);
+        std::vector<uint8_t> expected_lower(len * 2);
+        std::vector<uint8_t> expected_upper(len * 2);
+        std::vector<uint8_t> lower_out(len * 2);
+        std::vector<uint8_t> upper_out(len * 2);
+        encodeHexLower(expected_lower.data(), raw.data(), RawLength{len});
+        encodeHexUpper(expected_upper.data(), raw.data(), RawLength{len});
+        EncodeLower(lower_out.data(), raw.data(), RawLength{len});
+        EncodeUpper(upper_out.data(), raw.data(), RawLength{len});
+        REQUIRE(lower_out == expected_lower);
+        REQUIRE(upper_out == expected_upper);
+
+        std::vector<uint8_t> mixed(len * 2);
+        for (size_t i = 0; i < mixed.size(); ++i)
+            mixed[i] = (i % 3 == 0) ? expected_upper[i] : expected_lower[i];
+        std::vector<uint8_t> decoded(len);
+        Decode(decoded.data(), mixed.data(), RawLength{len});
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), raw.begin()));
+    }
+}
+
+TEST_CASE("SWAR_lengths")
+{
+    testLengths<encodeHexLowerSWAR, encodeHexUpperSWAR, decodeHexSWAR>();
+}
+
+#if defined(FAST_HEX_GENERIC_SIMD)
+TEST_CASE("Generic_lengths")
+{
+    testLengths<encodeHexLowerGeneric, encodeHexUpperGeneric, decodeHexGeneric>();
+}
+#endif
+
+#if defined(FAST_HEX_AVX2)
+TEST_CASE("Vec_lengths")
+{
+    testLengths<encodeHexLowerVec, encodeHexUpperVec, decodeHexVecMaddubs>();
+}
+#endif
+
 #ifndef FAST_HEX_STATIC_SHARED_LIBRARY
 TEST_CASE("decode_auto_invalid")
 {
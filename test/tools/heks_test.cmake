@@ -0,0 +1,114 @@
+# Round trips the heks binary itself (arbitrary bytes) through heks and, if
+# found, checks the output against xxd -p / xxd -r -p.
+#   cmake -DHEKS=<heks> [-DXXD=<xxd>] -DWORK_DIR=<dir> -P heks_test.cmake
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+set(input "${HEKS}")
+
+function(run)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "failed (${status}): ${ARGN}")
+    endif()
+endfunction()
+
+function(expect_same a b)
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -E compare_files "${a}" "${b}"
+        RESULT_VARIABLE different
+    )
+    if(different)
+        message(FATAL_ERROR "${a} and ${b} differ")
+    endif()
+endfunction()
+
+foreach(cols 30 16 1 300 0)
+    foreach(threads 1 3)
+        set(hex "${WORK_DIR}/c${cols}_j${threads}.hex")
+        set(bin "${WORK_DIR}/c${cols}_j${threads}.bin")
+        run("${HEKS}" -c ${cols} -j ${threads} "${input}" "${hex}")
+        run("${HEKS}" -r --strict -j ${threads} "${hex}" "${bin}")
+        expect_same("${input}" "${bin}")
+        if(XXD)
+            set(reference "${WORK_DIR}/c${cols}.xxd")
+            run("${XXD}" -p -c ${cols} "${input}" "${reference}")
+            expect_same("${reference}" "${hex}")
+        endif()
+    endforeach()
+endforeach()
+
+# C include file style, named input (with the declaration) and stdin
+if(XXD)
+    foreach(flags "-i" "-i;-u" "-i;-c;5" "-i;-c;0")
+        string(REPLACE ";" "" tag "${flags}")
+        run("${HEKS}" ${flags} -j 3 "${input}" "${WORK_DIR}/${tag}.h")
+        execute_process(
+            COMMAND "${XXD}" ${flags} "${input}"
+            OUTPUT_FILE "${WORK_DIR}/${tag}.xxd.h"
+        )
+        expect_same("${WORK_DIR}/${tag}.xxd.h" "${WORK_DIR}/${tag}.h")
+    endforeach()
+    execute_process(
+        COMMAND "${HEKS}" -i
+        INPUT_FILE "${input}"
+        OUTPUT_FILE "${WORK_DIR}/stdin.h"
+    )
+    execute_process(
+        COMMAND "${XXD}" -i
+        INPUT_FILE "${input}"
+        OUTPUT_FILE "${WORK_DIR}/stdin.xxd.h"
+    )
+    expect_same("${WORK_DIR}/stdin.xxd.h" "${WORK_DIR}/stdin.h")
+endif()
+
+# Stdin to stdout, upper case
+execute_process(
+    COMMAND "${HEKS}" -u
+    INPUT_FILE "${input}"
+    OUTPUT_FILE "${WORK_DIR}/upper.hex"
+    RESULT_VARIABLE status
+)
+execute_process(
+    COMMAND "${HEKS}" -r
+    INPUT_FILE "${WORK_DIR}/upper.hex"
+    OUTPUT_FILE "${WORK_DIR}/upper.bin"
+    RESULT_VARIABLE status2
+)
+if(status OR status2)
+    message(FATAL_ERROR "stdin/stdout round trip failed")
+endif()
+expect_same("${input}" "${WORK_DIR}/upper.bin")
+
+# Tolerant and strict decoding
+file(WRITE "${WORK_DIR}/noisy.hex" "0x41, 0x42;\n  43-44 z4\n5")
+run("${HEKS}" -r "${WORK_DIR}/noisy.hex" "${WORK_DIR}/noisy.bin")
+# Like xxd -r -p, "0x" discards the 0 and whitespace keeps the 4 of "4\n5"
+file(READ "${WORK_DIR}/noisy.bin" noisy HEX)
+if(NOT noisy STREQUAL "4142434445")
+    message(FATAL_ERROR "tolerant decode produced ${noisy}")
+endif()
+# Three non-digits in a row skip the rest of the line
+file(WRITE "${WORK_DIR}/garbage.hex" "41 42 ;;; 99\n43")
+run("${HEKS}" -r "${WORK_DIR}/garbage.hex" "${WORK_DIR}/garbage.bin")
+file(READ "${WORK_DIR}/garbage.bin" garbage HEX)
+if(NOT garbage STREQUAL "414243")
+    message(FATAL_ERROR "tolerant decode produced ${garbage}")
+endif()
+execute_process(
+    COMMAND "${HEKS}" -r --strict "${WORK_DIR}/noisy.hex"
+    OUTPUT_QUIET ERROR_QUIET
+    RESULT_VARIABLE status
+)
+if(status EQUAL 0)
+    message(FATAL_ERROR "strict decode accepted non-hex characters")
+endif()
+file(WRITE "${WORK_DIR}/odd.hex" "abc\n")
+execute_process(
+    COMMAND "${HEKS}" -r --strict "${WORK_DIR}/odd.hex"
+    OUTPUT_QUIET ERROR_QUIET
+    RESULT_VARIABLE status
+)
+if(status EQUAL 0)
+    message(FATAL_ERROR "strict decode accepted an odd digit count")
+endif()
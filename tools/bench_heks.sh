@@ -0,0 +1,50 @@
+#!/bin/sh
+# Compares heks with xxd -p / xxd -r -p / xxd -i and od on a random file and checks the outputs match.
+#   tools/bench_heks.sh <path/to/heks> [size in MiB, default 256] [threads, default 1]
+set -eu
+
+heks=${1:?usage: bench_heks.sh <path/to/heks> [MiB] [threads]}
+mib=${2:-256}
+threads=${3:-1}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+head -c $((mib * 1024 * 1024)) /dev/urandom > "$dir/in.bin"
+
+run() {
+    label=$1
+    shift
+    start=$(date +%s.%N)
+    "$@"
+    end=$(date +%s.%N)
+    echo "$label $start $end" | awk -v mib="$mib" '{ t = $3 - $2; printf "%-28s %8.3f s %10.1f MiB/s\n", $1, t, mib / t }'
+}
+
+echo "input: $mib MiB, heks threads: $threads"
+run "heks" "$heks" -j "$threads" "$dir/in.bin" "$dir/heks.hex"
+if command -v xxd > /dev/null; then
+    run "xxd-p" sh -c 'xxd -p "$1" > "$2"' sh "$dir/in.bin" "$dir/xxd.hex"
+    cmp "$dir/heks.hex" "$dir/xxd.hex"
+fi
+if command -v od > /dev/null; then
+    run "od-An-tx1" sh -c 'od -An -v -tx1 "$1" > "$2"' sh "$dir/in.bin" "$dir/od.hex"
+fi
+
+run "heks-r" "$heks" -r -j "$threads" "$dir/heks.hex" "$dir/heks.bin"
+cmp "$dir/in.bin" "$dir/heks.bin"
+if command -v xxd > /dev/null; then
+    run "xxd-r-p" sh -c 'xxd -r -p "$1" > "$2"' sh "$dir/heks.hex" "$dir/xxd.bin"
+    cmp "$dir/in.bin" "$dir/xxd.bin"
+fi
+if [ -e "$dir/od.hex" ]; then
+    # od output (spaces, 16 bytes per line) through the tolerant decoder
+    run "heks-r(od)" "$heks" -r -j "$threads" "$dir/od.hex" "$dir/od.bin"
+    cmp "$dir/in.bin" "$dir/od.bin"
+fi
+
+run "heks-i" "$heks" -i -j "$threads" "$dir/in.bin" "$dir/heks.h"
+if command -v xxd > /dev/null; then
+    run "xxd-i" sh -c 'xxd -i "$1" > "$2"' sh "$dir/in.bin" "$dir/xxd.h"
+    cmp "$dir/heks.h" "$dir/xxd.h"
+fi
+echo "outputs match"
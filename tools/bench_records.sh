@@ -0,0 +1,39 @@
+#!/bin/sh
+# Compares heks --ihex / --srec with objcopy on a random image; each decodes the records written by the other.
+#   tools/bench_records.sh <path/to/heks> [size in MiB, default 64]
+set -eu
+
+heks=${1:?usage: bench_records.sh <path/to/heks> [MiB]}
+mib=${2:-64}
+objcopy=${OBJCOPY:-objcopy}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+head -c $((mib * 1024 * 1024)) /dev/urandom > "$dir/in.bin"
+
+run() {
+    label=$1
+    shift
+    start=$(date +%s.%N)
+    "$@"
+    end=$(date +%s.%N)
+    echo "$label $start $end" | awk -v mib="$mib" '{ t = $3 - $2; printf "%-28s %8.3f s %10.1f MiB/s\n", $1, t, mib / t }'
+}
+
+echo "image: $mib MiB"
+for format in ihex srec; do
+    run "heks--$format" "$heks" "--$format" "$dir/in.bin" "$dir/heks.$format"
+    run "heks-r--$format" "$heks" -r "--$format" "$dir/heks.$format" "$dir/heks.bin"
+    cmp "$dir/in.bin" "$dir/heks.bin"
+    if command -v "$objcopy" > /dev/null; then
+        run "objcopy-O-$format" "$objcopy" -I binary -O "$format" "$dir/in.bin" "$dir/objcopy.$format"
+        run "objcopy-I-$format" "$objcopy" -I "$format" -O binary "$dir/objcopy.$format" "$dir/objcopy.bin"
+        cmp "$dir/in.bin" "$dir/objcopy.bin"
+        # Each reads the records of the other
+        run "heks-r--$format(objcopy)" "$heks" -r "--$format" "$dir/objcopy.$format" "$dir/cross.bin"
+        cmp "$dir/in.bin" "$dir/cross.bin"
+        "$objcopy" -I "$format" -O binary "$dir/heks.$format" "$dir/cross.bin"
+        cmp "$dir/in.bin" "$dir/cross.bin"
+    fi
+done
+echo "outputs match"
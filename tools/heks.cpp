@@ -0,0 +1,692 @@
+// heks - hex dump / reverse in the plain format of `xxd -p` / `xxd -r -p`, built on encode_auto/decode_auto.
+//
+//   heks [-u] [-c cols] [-j threads] [infile [outfile]]       encode ("-" or no file: stdin/stdout)
+//   heks -i [-u] [-c cols] [-j threads] [infile [outfile]]    C include file (encodeCArray)
+//   heks -r [--strict] [-j threads] [infile [outfile]]        decode
+//   heks --ihex|--srec [-c bytes] [infile [outfile]]          Intel HEX / S-records (RecordEncoder)
+//   heks -r --ihex|--srec [infile [outfile]]                  records to a binary image (RecordDecoder)
+//
+// Output of encoding is byte-identical to `xxd -p` (30 bytes = 60 characters per line by default), and
+// with -i to `xxd -i` (12 items per line, the array declaration when reading a named file).
+// Decoding gives the same bytes as `xxd -r -p` for any input, including its handling of garbage (see
+// Parser); input made of hex digits and whitespace only takes a branch free path. With --strict nothing
+// else is accepted and the number of digits must be even. Records are written from address 0 with 16 data
+// bytes each; reading them gives the image from the address of the first record, gaps filled with zeros.
+
+#include "fast_hex/fast_hex_carray.hpp"
+#include "fast_hex/fast_hex_inline.hpp"
+#include "fast_hex/fast_hex_records.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if FAST_HEX_USE_NAMESPACE
+using namespace heks;
+#endif
+
+namespace
+{
+
+constexpr size_t page_size = 4096;
+// Input processed per thread and batch
+constexpr size_t chunk_size = size_t{4} << 20;
+
+struct Options
+{
+    bool decode = false;
+    bool c_array = false;
+    bool upper = false;
+    bool strict = false;
+    std::optional<RecordFormat> records;
+    size_t cols = 30; // bytes per line, 0 = a single line
+    bool cols_given = false;
+    unsigned threads = 1;
+    const char * input = nullptr;
+    const char * output = nullptr;
+};
+
+[[noreturn]] void usage(int status)
+{
+    std::fputs(
+        "usage: heks [-p] [-u] [-c cols] [-j threads] [infile [outfile]]\n"
+        "       heks -i [-u] [-c cols] [-j threads] [infile [outfile]]\n"
+        "       heks -r [-p] [--strict] [-j threads] [infile [outfile]]\n"
+        "       heks [-r] --ihex|--srec [-c bytes] [infile [outfile]]\n"
+        "  -c cols    bytes per output line (default 30, 0 = one line; with -i default and 0: 12)\n"
+        "  -i         output in C include file style, like xxd -i\n"
+        "  -u         upper case hex digits\n"
+        "  -r         reverse: hex to binary (non-hex characters are handled like xxd -r -p)\n"
+        "  --strict   with -r: fail on characters other than hex digits and whitespace, or an odd digit count\n"
+        "  --ihex     Intel HEX records from address 0 (-c bytes per record, default 16); with -r the image\n"
+        "             from the first record's address, gaps filled with zeros\n"
+        "  --srec     Motorola S-records, like --ihex\n"
+        "  -j threads worker threads (default 1, 0 = all cores)\n"
+        "  -p         accepted for xxd compatibility (plain hex is the only format)\n",
+        status == 0 ? stdout : stderr);
+    std::exit(status);
+}
+
+[[noreturn]] void fail(const char * what, const char * detail = nullptr)
+{
+    if (detail != nullptr)
+        std::fprintf(stderr, "heks: %s: %s\n", what, detail);
+    else
+        std::fprintf(stderr, "heks: %s\n", what);
+    std::exit(1);
+}
+
+Options parse(int argc, char ** argv)
+{
+    Options options;
+    int files = 0;
+    auto number = [&](int & i, const char * flag) -> unsigned long
+    {
+        if (i + 1 >= argc)
+            fail("missing value for", flag);
+        char * end = nullptr;
+        const auto value = std::strtoul(argv[++i], &end, 0);
+        if (end == argv[i] || *end != '\0')
+            fail("invalid number", argv[i]);
+        return value;
+    };
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--strict")
+            options.strict = true;
+        else if (arg == "--ihex")
+            options.records = RecordFormat::IntelHex;
+        else if (arg == "--srec")
+            options.records = RecordFormat::SRecord;
+        else if (arg == "--help" || arg == "-h")
+            usage(0);
+        else if (arg == "-c" || arg == "-cols")
+        {
+            options.cols = number(i, "-c");
+            options.cols_given = true;
+        }
+        else if (arg == "-j")
+            options.threads = static_cast<unsigned>(number(i, "-j"));
+        else if (arg.size() > 1 && arg[0] == '-' && arg != "-")
+        {
+            // Clusters of single letter flags, e.g. -rp or -ps
+            for (const char flag : arg.substr(1))
+            {
+                if (flag == 'r')
+                    options.decode = true;
+                else if (flag == 'i')
+                    options.c_array = true;
+                else if (flag == 'u')
+                    options.upper = true;
+                else if (flag != 'p' && flag != 's')
+                    usage(1);
+            }
+        }
+        else if (files == 0)
+            options.input = argv[i], ++files;
+        else if (files == 1)
+            options.output = argv[i], ++files;
+        else
+            usage(1);
+    }
+    if (options.threads == 0)
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    return options;
+}
+
+struct FreeDeleter
+{
+    void operator()(uint8_t * p) const { std::free(p); }
+};
+using Buffer = std::unique_ptr<uint8_t[], FreeDeleter>;
+
+Buffer allocate(size_t bytes)
+{
+    void * p = nullptr;
+    if (posix_memalign(&p, page_size, std::max(bytes, page_size)) != 0)
+        fail("out of memory");
+    return Buffer(static_cast<uint8_t *>(p));
+}
+
+// A regular file is mapped, anything else (pipes, terminals) is read in chunks
+class Input
+{
+public:
+    explicit Input(const char * path)
+    {
+        if (path != nullptr && std::string_view(path) != "-")
+        {
+            fd_ = ::open(path, O_RDONLY);
+            if (fd_ < 0)
+                fail(path, std::strerror(errno));
+        }
+        struct stat st{};
+        if (::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        {
+            size_ = static_cast<size_t>(st.st_size);
+            void * p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (p != MAP_FAILED)
+            {
+                map_ = static_cast<const uint8_t *>(p);
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+    }
+
+    ~Input()
+    {
+        if (map_ != nullptr)
+            ::munmap(const_cast<uint8_t *>(map_), size_);
+        if (fd_ > 0)
+            ::close(fd_);
+    }
+
+    Input(const Input &) = delete;
+    Input & operator=(const Input &) = delete;
+
+    // Up to max bytes; fewer only at the end of the input. Valid until the next call.
+    std::pair<const uint8_t *, size_t> next(size_t max)
+    {
+        if (map_ != nullptr)
+        {
+            const size_t n = std::min(max, size_ - offset_);
+            const uint8_t * p = map_ + offset_;
+            offset_ += n;
+            return {p, n};
+        }
+        if (capacity_ < max)
+        {
+            buffer_ = allocate(max);
+            capacity_ = max;
+        }
+        size_t n = 0;
+        while (n < max)
+        {
+            const ssize_t got = ::read(fd_, buffer_.get() + n, max - n);
+            if (got == 0)
+                break;
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                fail("read", std::strerror(errno));
+            }
+            n += static_cast<size_t>(got);
+        }
+        return {buffer_.get(), n};
+    }
+
+private:
+    int fd_ = STDIN_FILENO;
+    const uint8_t * map_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    Buffer buffer_;
+    size_t capacity_ = 0;
+};
+
+class Output
+{
+public:
+    explicit Output(const char * path)
+    {
+        if (path != nullptr && std::string_view(path) != "-")
+        {
+            fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            if (fd_ < 0)
+                fail(path, std::strerror(errno));
+        }
+    }
+
+    ~Output()
+    {
+        if (fd_ != STDOUT_FILENO)
+            ::close(fd_);
+    }
+
+    Output(const Output &) = delete;
+    Output & operator=(const Output &) = delete;
+
+    void write(const uint8_t * data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t done = ::write(fd_, data, size);
+            if (done < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                fail("write", std::strerror(errno));
+            }
+            data += done;
+            size -= static_cast<size_t>(done);
+        }
+    }
+
+private:
+    int fd_ = STDOUT_FILENO;
+};
+
+// Calls f(0) .. f(count - 1), one per thread
+template <typename F>
+void parallel(size_t count, F f)
+{
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < count; ++i)
+        workers.emplace_back(f, i);
+    f(size_t{0});
+    for (auto & worker : workers)
+        worker.join();
+}
+
+void encode(uint8_t * dest, const uint8_t * src, size_t length, bool upper_case)
+{
+    if (upper_case)
+        encode_auto(dest, src, RawLength{length}, upper);
+    else
+        encode_auto(dest, src, RawLength{length}, lower);
+}
+
+// Hex lines of a piece starting on a line boundary. scratch holds 2 * size bytes.
+size_t encode_lines(uint8_t * out, const uint8_t * in, size_t size, const Options & options, uint8_t * scratch)
+{
+    const size_t cols = options.cols;
+    if (cols == 0)
+    {
+        encode(out, in, size, options.upper);
+        return size * 2;
+    }
+    uint8_t * p = out;
+    if (cols >= 256)
+    {
+        // Long lines: encode each line in place
+        for (size_t done = 0; done < size; done += cols)
+        {
+            const size_t n = std::min(cols, size - done);
+            encode(p, in + done, n, options.upper);
+            p += n * 2;
+            *p++ = '\n';
+        }
+        return static_cast<size_t>(p - out);
+    }
+    // Short lines: one encode call for the piece, then split it into lines
+    encode(scratch, in, size, options.upper);
+    for (size_t done = 0; done < size; done += cols)
+    {
+        const size_t n = std::min(cols, size - done);
+        std::memcpy(p, scratch + done * 2, n * 2);
+        p += n * 2;
+        *p++ = '\n';
+    }
+    return static_cast<size_t>(p - out);
+}
+
+int run_encode(const Options & options)
+{
+    Input input(options.input);
+    Output output(options.output);
+
+    // Pieces (one per thread) hold whole lines
+    size_t piece = chunk_size;
+    if (options.cols > 0)
+        piece = std::max<size_t>(1, piece / options.cols) * options.cols;
+    const size_t threads = options.threads;
+    const size_t batch = piece * threads;
+    const size_t piece_out = piece * 2 + (options.cols > 0 ? piece / options.cols + 1 : 0);
+
+    Buffer out = allocate(piece_out * threads);
+    Buffer scratch = allocate(piece * 2 * threads);
+    std::vector<size_t> written(threads);
+    for (;;)
+    {
+        const auto [data, size] = input.next(batch);
+        if (size == 0)
+            break;
+        const size_t pieces = std::min(threads, (size + piece - 1) / piece);
+        parallel(
+            pieces,
+            [&, data = data, size = size](size_t i)
+            {
+                const size_t begin = i * piece;
+                const size_t n = std::min(piece, size - begin);
+                written[i] = encode_lines(out.get() + i * piece_out, data + begin, n, options, scratch.get() + i * piece * 2);
+            });
+        for (size_t i = 0; i < pieces; ++i)
+            output.write(out.get() + i * piece_out, written[i]);
+        if (size < batch)
+            break;
+    }
+    // xxd -p -c 0 ends with a newline even for empty input
+    if (options.cols == 0)
+        output.write(reinterpret_cast<const uint8_t *>("\n"), 1);
+    return 0;
+}
+
+// xxd -i's variable name for a file name: characters other than letters and digits become '_',
+// with "__" in front of a leading digit
+std::string c_array_name(std::string_view path)
+{
+    std::string name = !path.empty() && path[0] >= '0' && path[0] <= '9' ? "__" : "";
+    for (const char c : path)
+        name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    return name;
+}
+
+int run_c_array(const Options & options)
+{
+    Input input(options.input);
+    Output output(options.output);
+    auto text = [&](std::string_view s) { output.write(reinterpret_cast<const uint8_t *>(s.data()), s.size()); };
+
+    const bool named = options.input != nullptr && std::string_view(options.input) != "-";
+    const std::string name = named ? c_array_name(options.input) : std::string();
+    if (named)
+        text("unsigned char " + name + "[] = {\n");
+
+    // Like xxd -i, -c 0 is the default of 12 items per line
+    const CArrayOptions c_array{.columns = options.cols_given && options.cols > 0 ? options.cols : 12, .upper_prefix = options.upper};
+    const size_t piece = std::max<size_t>(1, chunk_size / c_array.columns) * c_array.columns;
+    const size_t threads = options.threads;
+    const size_t batch = piece * threads;
+    // One more for the comma of the last item, unless it ends the input
+    const size_t piece_out = c_array_size(RawLength{piece}, c_array) + 1;
+
+    Buffer out = allocate(piece_out * threads);
+    std::vector<size_t> written(threads);
+    size_t total = 0;
+    bool pending = false; // the newline of the last line written, and a comma if more items follow
+    for (;;)
+    {
+        const auto [data, size] = input.next(batch);
+        if (size == 0)
+            break;
+        if (pending)
+            text(",\n");
+        const size_t pieces = std::min(threads, (size + piece - 1) / piece);
+        parallel(
+            pieces,
+            [&, data = data, size = size](size_t i)
+            {
+                const size_t begin = i * piece;
+                const size_t n = std::min(piece, size - begin);
+                uint8_t * dest = out.get() + i * piece_out;
+                size_t w = options.upper ? encodeCArray(dest, data + begin, RawLength{n}, upper, c_array)
+                                         : encodeCArray(dest, data + begin, RawLength{n}, lower, c_array);
+                if (i + 1 < pieces)
+                {
+                    dest[w - 1] = ',';
+                    dest[w++] = '\n';
+                }
+                else
+                    --w;
+                written[i] = w;
+            });
+        for (size_t i = 0; i < pieces; ++i)
+            output.write(out.get() + i * piece_out, written[i]);
+        pending = true;
+        total += size;
+        if (size < batch)
+            break;
+    }
+    if (pending)
+        text("\n");
+    if (named)
+        text("};\nunsigned int " + name + "_len = " + std::to_string(total) + ";\n");
+    return 0;
+}
+
+// 1: hex digit, 2: whitespace skipped by xxd -r -p, 0: anything else
+constexpr std::array<uint8_t, 256> char_classes = []
+{
+    std::array<uint8_t, 256> classes{};
+    for (int c = '0'; c <= '9'; ++c)
+        classes[static_cast<size_t>(c)] = 1;
+    for (int c = 'a'; c <= 'f'; ++c)
+        classes[static_cast<size_t>(c)] = 1;
+    for (int c = 'A'; c <= 'F'; ++c)
+        classes[static_cast<size_t>(c)] = 1;
+    for (char c : {' ', '\n', '\r', '\t'})
+        classes[static_cast<uint8_t>(c)] = 2;
+    return classes;
+}();
+
+// Copies the hex digits of in to out without branching and returns their count. Sets other when
+// characters other than digits and whitespace are present.
+size_t filter_digits(uint8_t * out, const uint8_t * in, size_t size, bool & other)
+{
+    size_t count = 0;
+    uint8_t others = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint8_t c = in[i];
+        const uint8_t cls = char_classes[c];
+        out[count] = c;
+        count += cls & 1;
+        others |= static_cast<uint8_t>(cls == 0);
+    }
+    other = others != 0;
+    return count;
+}
+
+// State of the xxd -r -p parser between pieces. xxd pairs two consecutive digits; a non-hex character
+// (other than whitespace) in between discards the first one, and three non-digits in a row (the second
+// digit of a pair counts as one) skip the rest of the line. digit is the odd digit waiting for its
+// partner (xxd's n1), previous tells whether the character before it was a digit (n2 >= 0).
+struct Parser
+{
+    int digit = -1;
+    bool previous = true;
+    bool ignore = true; // non-digits at the start of the input and of skipped lines are ignored
+    bool skipping = false; // inside a line being skipped
+
+    // Appends the digits of in to out, returns the end of the output. An odd digit waiting for its
+    // partner is the last one written and is taken back if discarded.
+    uint8_t * parse(uint8_t * out, const uint8_t * in, size_t size)
+    {
+        const uint8_t * end = in + size;
+        while (in != end)
+        {
+            if (skipping)
+            {
+                in = static_cast<const uint8_t *>(std::memchr(in, '\n', static_cast<size_t>(end - in)));
+                if (in == nullptr)
+                    return out;
+                ++in;
+                skipping = false;
+                ignore = true;
+                continue;
+            }
+            const uint8_t c = *in++;
+            const uint8_t cls = char_classes[c];
+            if (cls == 2)
+                continue;
+            const bool before_previous = previous;
+            previous = digit >= 0;
+            digit = cls == 1 ? c : -1;
+            if (digit < 0 && ignore)
+                continue;
+            ignore = false;
+            if (digit >= 0)
+            {
+                // The first digit of a pair was written when it arrived
+                *out++ = c;
+                if (previous)
+                    digit = -1;
+            }
+            else if (previous)
+                --out; // discard the odd digit
+            else if (!before_previous)
+                skipping = true;
+        }
+        return out;
+    }
+};
+
+int run_decode(const Options & options)
+{
+    Input input(options.input);
+    Output output(options.output);
+
+    const size_t threads = options.threads;
+    const size_t piece = chunk_size;
+    const size_t batch = piece * threads;
+    // Digit pairs of a batch; digits[0] may hold the odd digit carried over from the previous batch
+    Buffer digits = allocate(batch + 1);
+    Buffer filtered = allocate(batch);
+    Buffer out = allocate(batch / 2 + 1);
+    std::vector<size_t> counts(threads);
+    std::vector<char> other(threads);
+    Parser parser;
+    size_t carry = 0;
+    size_t consumed = 0;
+    for (;;)
+    {
+        const auto [data, size] = input.next(batch);
+        if (size == 0)
+            break;
+        const size_t pieces = std::min(threads, (size + piece - 1) / piece);
+        parallel(
+            pieces,
+            [&, data = data, size = size](size_t i)
+            {
+                const size_t begin = i * piece;
+                bool bad = false;
+                counts[i] = filter_digits(filtered.get() + begin, data + begin, std::min(piece, size - begin), bad);
+                other[i] = bad;
+            });
+
+        // Pieces of digits and whitespace take the filtered digits, anything else goes through the parser
+        size_t total = carry;
+        for (size_t i = 0; i < pieces; ++i)
+        {
+            const size_t begin = i * piece;
+            const size_t n = std::min(piece, size - begin);
+            if (other[i] && options.strict)
+            {
+                const uint8_t * in = data + begin;
+                const auto at = static_cast<size_t>(std::find_if(in, in + n, [](uint8_t c) { return char_classes[c] == 0; }) - in);
+                std::fprintf(stderr, "heks: invalid character 0x%02x at offset %zu\n", in[at], consumed + begin + at);
+                return 1;
+            }
+            if (other[i] || parser.skipping)
+            {
+                parser.digit = total % 2 != 0 ? digits[total - 1] : -1;
+                total = static_cast<size_t>(parser.parse(digits.get() + total, data + begin, n) - digits.get());
+                continue;
+            }
+            std::memmove(digits.get() + total, filtered.get() + begin, counts[i]);
+            total += counts[i];
+            if (counts[i] > 0)
+            {
+                parser.ignore = false;
+                parser.digit = total % 2 != 0 ? digits[total - 1] : -1;
+                parser.previous = total % 2 == 0;
+            }
+        }
+        consumed += size;
+
+        const size_t bytes = total / 2;
+        const size_t per_thread = (bytes + pieces - 1) / pieces;
+        parallel(
+            pieces,
+            [&](size_t i)
+            {
+                const size_t begin = std::min(bytes, i * per_thread);
+                const size_t n = std::min(per_thread, bytes - begin);
+                decode_auto(out.get() + begin, digits.get() + begin * 2, RawLength{n});
+            });
+        output.write(out.get(), bytes);
+        carry = total % 2;
+        if (carry != 0)
+            digits[0] = digits[total - 1];
+        if (size < batch)
+            break;
+    }
+    if (carry != 0 && options.strict)
+    {
+        std::fputs("heks: odd number of hex digits\n", stderr);
+        return 1;
+    }
+    return 0;
+}
+
+int run_records_encode(const Options & options)
+{
+    Input input(options.input);
+    Output output(options.output);
+    RecordEncoder encoder(*options.records, {.record_size = options.cols_given && options.cols > 0 ? options.cols : 16});
+    Buffer out = allocate(encoder.max_encoded_size(chunk_size));
+    for (;;)
+    {
+        const auto [data, size] = input.next(chunk_size);
+        output.write(out.get(), encoder.encode(out.get(), data, size));
+        if (size < chunk_size)
+            break;
+    }
+    output.write(out.get(), encoder.finish(out.get()));
+    return 0;
+}
+
+int run_records_decode(const Options & options)
+{
+    Input input(options.input);
+    Output output(options.output);
+    RecordDecoder decoder(*options.records, chunk_size);
+    // Address following the bytes written so far
+    std::optional<uint64_t> next;
+    const std::vector<uint8_t> zeros(page_size * 16);
+    auto sink = [&](uint32_t address, const uint8_t * data, size_t size)
+    {
+        if (next && address < *next)
+            fail("records out of address order");
+        for (uint64_t gap = next ? address - *next : 0; gap > 0;)
+        {
+            const size_t n = std::min<uint64_t>(gap, zeros.size());
+            output.write(zeros.data(), n);
+            gap -= n;
+        }
+        output.write(data, size);
+        next = uint64_t{address} + size;
+    };
+    for (;;)
+    {
+        const auto [data, size] = input.next(chunk_size);
+        if (decoder.decode(data, size, sink) || size < chunk_size)
+            break;
+    }
+    if (decoder.finish(sink))
+    {
+        std::fprintf(stderr, "heks: invalid record at line %zu\n", decoder.line());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    const Options options = parse(argc, argv);
+    if (options.records)
+        return options.decode ? run_records_decode(options) : run_records_encode(options);
+    if (options.decode)
+        return run_decode(options);
+    return options.c_array ? run_c_array(options) : run_encode(options);
+}